@@ -0,0 +1,452 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Times each stage of a menu build over a synthetic, reproducible XDG tree
+// Results are printed as a single JSON object, one entry per stage
+
+#include <ftw.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "filex.h"
+#include "menu.h"
+#include "system_environment.h"
+#include "desktop_entry_file_search.h"
+#include "qualified_icon_theme.h"
+#include "xdg/desktop_entry.h"
+#include "icon_search/caching_search.h"
+#include "icon_search/xdg_search.h"
+#include "transformer/jwm.h"
+
+namespace amm {
+namespace bench {
+
+struct Options
+{
+    size_t desktop_files = 2000;
+    size_t theme_subdirectories = 40;
+    size_t inheritance_depth = 8;
+    size_t repetitions = 5;
+    size_t jobs = 1;
+    std::string fixtures_directory;
+};
+
+struct Stage
+{
+    std::string name;
+    size_t items;
+    std::vector<double> seconds;
+};
+
+const char *kCategories[] = {
+    "AudioVideo;Audio;Player;", "AudioVideo;Video;", "Development;IDE;", "Education;Science;",
+    "Game;ArcadeGame;", "Graphics;2DGraphics;", "Network;WebBrowser;", "Office;WordProcessor;",
+    "Settings;DesktopSettings;", "System;TerminalEmulator;", "Utility;TextEditor;", "X-Bench-Unclassified;"
+};
+
+const char *kContexts[] = { "apps", "categories", "devices", "emblems", "mimetypes", "places", "status", "actions" };
+const char *kContextNames[] = { "Applications", "Categories", "Devices", "Emblems", "MimeTypes", "Places", "Status", "Actions" };
+
+const int kSizes[] = { 16, 22, 24, 32, 48, 64, 96, 128, 256, 0 };
+
+void makeDirectory(const std::string &name)
+{
+    std::string partial;
+    std::stringstream stream(name);
+    std::string part;
+    while (std::getline(stream, part, '/')) {
+        partial += part + "/";
+        mkdir(partial.c_str(), 0755);
+    }
+}
+
+void writeFile(const std::string &name, const std::string &content)
+{
+    auto file = fopen(name.c_str(), "w");
+    if (file == nullptr) {
+        std::cerr << "amm_bench: couldn't write " << name << std::endl;
+        exit(1);
+    }
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+}
+
+std::string numbered(const std::string &prefix, size_t number)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%05zu", number);
+    return prefix + buffer;
+}
+
+std::string subdirectoryName(size_t index)
+{
+    auto size = kSizes[index % (sizeof(kSizes) / sizeof(kSizes[0]))];
+    auto context = std::string { kContexts[(index / (sizeof(kSizes) / sizeof(kSizes[0]))) % (sizeof(kContexts) / sizeof(kContexts[0]))] };
+    auto name = size == 0 ? std::string { "scalable" } : std::to_string(size) + "x" + std::to_string(size);
+    auto round = index / (sizeof(kSizes) / sizeof(kSizes[0]) * sizeof(kContexts) / sizeof(kContexts[0]));
+    return name + "/" + context + (round == 0 ? "" : std::to_string(round));
+}
+
+std::string contextName(const std::string &subdirectory)
+{
+    auto context = subdirectory.substr(subdirectory.find('/') + 1);
+    for (size_t i = 0; i < sizeof(kContexts) / sizeof(kContexts[0]); ++i) {
+        if (context.compare(0, strlen(kContexts[i]), kContexts[i]) == 0) {
+            return kContextNames[i];
+        }
+    }
+    return "";
+}
+
+std::string indexTheme(const std::string &name, const std::string &parent, const std::vector<std::string> &subdirectories)
+{
+    std::stringstream stream;
+    stream << "[Icon Theme]\nName=" << name << "\nComment=Synthetic theme for amm_bench\n";
+    if (parent != "") {
+        stream << "Inherits=" << parent << "\n";
+    }
+    stream << "Directories=";
+    for (size_t i = 0; i < subdirectories.size(); ++i) {
+        stream << (i == 0 ? "" : ",") << subdirectories[i];
+    }
+    stream << "\n";
+
+    for (const auto &subdirectory : subdirectories) {
+        auto is_scalable = subdirectory.compare(0, 8, "scalable") == 0;
+        auto size = is_scalable ? 48 : std::stoi(subdirectory);
+        stream << "\n[" << subdirectory << "]\nSize=" << size << "\nContext=" << contextName(subdirectory) << "\n";
+        stream << "Type=" << (is_scalable ? "Scalable\nMinSize=8\nMaxSize=512" : "Threshold") << "\n";
+    }
+    return stream.str();
+}
+
+// The tree is a function of the options only, so runs with the same options are comparable
+// Every fourth desktop file shares an icon, one in ten icons is missing from every theme,
+// and the themes bench-0 .. bench-N inherit from each other before reaching hicolor
+void generateFixtures(const Options &options, const std::string &root)
+{
+    auto applications = root + "/share/applications";
+    auto icons = root + "/share/icons";
+    makeDirectory(root + "/home");
+    makeDirectory(applications);
+
+    auto icon_count = std::max<size_t>(1, options.desktop_files / 4);
+    for (size_t i = 0; i < options.desktop_files; ++i) {
+        auto directory = i % 10 == 9 ? applications + "/" + numbered("vendor-", i % 7) : applications;
+        makeDirectory(directory);
+        auto icon = i % 10 == 3 ? numbered("missing-", i) : numbered("icon-", i % icon_count);
+        std::stringstream stream;
+        stream << "[Desktop Entry]\nVersion=1.0\nType=Application\n"
+               << "Name=" << numbered("Application ", i) << "\n"
+               << "Name[de]=" << numbered("Anwendung ", i) << "\n"
+               << "GenericName=Synthetic application\n"
+               << "Comment=Synthetic desktop file " << i << " for amm_bench\n"
+               << "Comment[de]=Synthetische Desktop-Datei " << i << "\n"
+               << "Exec=" << numbered("app-", i) << " %U\n"
+               << "Icon=" << icon << "\n"
+               << "Terminal=false\n"
+               << "Categories=" << kCategories[i % (sizeof(kCategories) / sizeof(kCategories[0]))] << "\n"
+               << "NoDisplay=" << (i % 50 == 7 ? "true" : "false") << "\n"
+               << "\n[Desktop Action new-window]\nName=New Window\nExec=" << numbered("app-", i) << " --new-window\n";
+        writeFile(directory + "/" + numbered("app-", i) + ".desktop", stream.str());
+    }
+
+    std::vector<std::string> hicolor_subdirectories;
+    for (size_t i = 0; i < std::max<size_t>(1, options.theme_subdirectories); ++i) {
+        hicolor_subdirectories.push_back(subdirectoryName(i));
+        makeDirectory(icons + "/hicolor/" + hicolor_subdirectories.back());
+    }
+    writeFile(icons + "/hicolor/index.theme", indexTheme("Hicolor", "", hicolor_subdirectories));
+    // Desktop file icons are application icons, so they live in the Applications and Categories contexts as in real themes
+    std::vector<std::string> icon_subdirectories;
+    for (const auto &subdirectory : hicolor_subdirectories) {
+        auto context = contextName(subdirectory);
+        if (context == "Applications" || context == "Categories") {
+            icon_subdirectories.push_back(subdirectory);
+        }
+    }
+    if (icon_subdirectories.empty()) {
+        icon_subdirectories = hicolor_subdirectories;
+    }
+    for (size_t i = 0; i < icon_count; ++i) {
+        if (i % 10 == 3) {
+            continue;
+        }
+        auto icon = numbered("icon-", i);
+        writeFile(icons + "/hicolor/" + icon_subdirectories[i % icon_subdirectories.size()] + "/" + icon + ".png", "");
+        writeFile(icons + "/hicolor/" + icon_subdirectories[(i * 7 + 3) % icon_subdirectories.size()] + "/" + icon + ".svg", "");
+    }
+
+    std::vector<std::string> link_subdirectories = { "48x48/apps", "scalable/apps" };
+    for (size_t depth = 0; depth < options.inheritance_depth; ++depth) {
+        auto name = numbered("bench-", depth);
+        auto parent = depth + 1 == options.inheritance_depth ? std::string { "hicolor" } : numbered("bench-", depth + 1);
+        for (const auto &subdirectory : link_subdirectories) {
+            makeDirectory(icons + "/" + name + "/" + subdirectory);
+        }
+        writeFile(icons + "/" + name + "/index.theme", indexTheme(name, parent, link_subdirectories));
+        // Each theme in the chain overrides a small slice of the icons
+        for (size_t i = depth; i < icon_count; i += 50) {
+            writeFile(icons + "/" + name + "/48x48/apps/" + numbered("icon-", i) + ".png", "");
+        }
+    }
+}
+
+int removeEntry(const char *path, const struct stat *, int, struct FTW *)
+{
+    return remove(path);
+}
+
+void removeFixtures(const std::string &root)
+{
+    nftw(root.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+double timed(const std::function<void()> &action)
+{
+    auto start = std::chrono::steady_clock::now();
+    action();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void record(std::vector<Stage> *stages, const std::string &name, size_t items, double seconds)
+{
+    for (auto &stage : *stages) {
+        if (stage.name == name) {
+            stage.items = items;
+            stage.seconds.push_back(seconds);
+            return;
+        }
+    }
+    stages->push_back(Stage { name, items, { seconds } });
+}
+
+// Runs the stages in the order amm does, each on fresh objects so nothing is carried across repetitions
+void runOnce(const Options &options, const std::string &root, std::vector<Stage> *stages)
+{
+    DesktopEntryFileSearch file_search;
+    file_search.registerDirectories({ root + "/share/applications" });
+    auto discovery = timed([&] { file_search.resolve(); });
+    auto file_names = file_search.desktopEntryFileNames();
+    record(stages, "discovery", file_names.size(), discovery);
+
+    std::vector<xdg::DesktopEntry> entries(file_names.size());
+    auto parse = timed([&] {
+        std::string content;
+        for (size_t i = 0; i < file_names.size(); ++i) {
+            if (FileX(file_names[i]).readAll(&content)) {
+                entries[i].hasLanguage("de");
+                entries[i].parse(content.data(), content.data() + content.size());
+            }
+        }
+    });
+    record(stages, "parse", file_names.size(), parse);
+
+    Menu menu;
+    menu.registerLanguage("de");
+    menu.registerJobs(options.jobs);
+    auto populate = timed([&] { menu.populate(file_names); });
+    record(stages, "populate", file_names.size(), populate);
+
+    auto classify = timed([&] { menu.refresh({}); });
+    record(stages, "classify", file_names.size(), classify);
+
+    auto sort = timed([&] { menu.sort(); });
+    record(stages, "sort", menu.subcategories().size(), sort);
+
+    std::set<std::string> icon_names;
+    for (const auto &entry : entries) {
+        icon_names.insert(entry.icon());
+    }
+
+    icon_search::CachingSearch *icon_searcher = nullptr;
+    auto theme = timed([&] {
+        SystemEnvironment environment;
+        QualifiedIconTheme qualified_theme(environment, numbered("bench-", 0));
+        icon_searcher = new icon_search::CachingSearch(new icon_search::XdgSearch(48, qualified_theme));
+    });
+    record(stages, "theme", options.inheritance_depth + 1, theme);
+    menu.registerIconService(icon_searcher);
+
+    auto icon_resolve = timed([&] {
+        for (const auto &icon_name : icon_names) {
+            icon_searcher->resolvedName(icon_name);
+        }
+    });
+    record(stages, "icon_resolve", icon_names.size(), icon_resolve);
+
+    std::string output;
+    auto transform = timed([&] {
+        transformer::Jwm jwm_transformer;
+        menu.transform(jwm_transformer, &output);
+    });
+    record(stages, "transform", output.size(), transform);
+
+    auto output_file_name = root + "/home/menu";
+    remove(output_file_name.c_str());
+    auto write = timed([&] { FileX(output_file_name).writeAll(output); });
+    record(stages, "write", output.size(), write);
+}
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    auto middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+void report(const Options &options, const std::vector<Stage> &stages)
+{
+    std::stringstream stream;
+    stream.precision(9);
+    stream << std::fixed;
+    stream << "{\n  \"desktop_files\": " << options.desktop_files
+           << ",\n  \"theme_subdirectories\": " << options.theme_subdirectories
+           << ",\n  \"inheritance_depth\": " << options.inheritance_depth
+           << ",\n  \"repetitions\": " << options.repetitions
+           << ",\n  \"jobs\": " << options.jobs
+           << ",\n  \"stages\": [\n";
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const auto &seconds = stages[i].seconds;
+        double total = 0;
+        for (auto value : seconds) {
+            total += value;
+        }
+        stream << "    { \"name\": \"" << stages[i].name << "\", \"items\": " << stages[i].items
+               << ", \"min_seconds\": " << *std::min_element(seconds.begin(), seconds.end())
+               << ", \"median_seconds\": " << median(seconds)
+               << ", \"mean_seconds\": " << total / seconds.size() << " }"
+               << (i + 1 == stages.size() ? "\n" : ",\n");
+    }
+    stream << "  ]\n}\n";
+    std::cout << stream.str();
+}
+
+void usage()
+{
+    std::cout << "Usage: amm_bench [options]\n\n"
+              << "  -n, --desktop-files NUMBER          desktop files to generate (default 2000)\n"
+              << "  -m, --theme-subdirectories NUMBER   sub-directories in the hicolor theme (default 40)\n"
+              << "  -d, --inheritance-depth NUMBER      themes inheriting from each other before hicolor (default 8)\n"
+              << "  -r, --repetitions NUMBER            times each stage is run (default 5)\n"
+              << "  -j, --jobs NUMBER                   threads used to read desktop files (default 1)\n"
+              << "  -f, --fixtures DIRECTORY            generate into DIRECTORY and keep it\n"
+              << "  -h, --help                          show this help\n";
+}
+
+bool positive(const char *text, size_t *value)
+{
+    char *end = nullptr;
+    auto number = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || number <= 0) {
+        return false;
+    }
+    *value = static_cast<size_t>(number);
+    return true;
+}
+
+bool parse(int argc, char **argv, Options *options)
+{
+    const char *short_options = "n:m:d:r:j:f:h";
+    const struct option long_options[] = {
+        { "desktop-files",        required_argument, 0, 'n' },
+        { "theme-subdirectories", required_argument, 0, 'm' },
+        { "inheritance-depth",    required_argument, 0, 'd' },
+        { "repetitions",          required_argument, 0, 'r' },
+        { "jobs",                 required_argument, 0, 'j' },
+        { "fixtures",             required_argument, 0, 'f' },
+        { "help",                 no_argument,       0, 'h' },
+        { 0,                      0,                 0, 0 }
+    };
+
+    int chosen_option;
+    while ((chosen_option = getopt_long(argc, argv, short_options, long_options, nullptr)) != -1) {
+        auto is_valid = true;
+        switch (chosen_option) {
+        case 'n': is_valid = positive(optarg, &options->desktop_files); break;
+        case 'm': is_valid = positive(optarg, &options->theme_subdirectories); break;
+        case 'd': is_valid = positive(optarg, &options->inheritance_depth); break;
+        case 'r': is_valid = positive(optarg, &options->repetitions); break;
+        case 'j': is_valid = positive(optarg, &options->jobs); break;
+        case 'f': options->fixtures_directory = optarg; break;
+        case 'h': usage(); exit(0);
+        default: is_valid = false;
+        }
+        if (!is_valid) {
+            usage();
+            return false;
+        }
+    }
+    return optind == argc;
+}
+
+} // namespace bench
+} // namespace amm
+
+int main(int argc, char *argv[])
+{
+    amm::bench::Options options;
+    if (!amm::bench::parse(argc, argv, &options)) {
+        return 2;
+    }
+
+    auto root = options.fixtures_directory;
+    auto is_temporary = root == "";
+    if (is_temporary) {
+        auto *tmpdir = getenv("TMPDIR");
+        auto pattern = std::string { tmpdir != nullptr ? tmpdir : "/tmp" } + "/amm_bench.XXXXXX";
+        std::vector<char> buffer(pattern.begin(), pattern.end());
+        buffer.push_back('\0');
+        if (mkdtemp(buffer.data()) == nullptr) {
+            std::cerr << "amm_bench: couldn't create a directory for fixtures" << std::endl;
+            return 1;
+        }
+        root = buffer.data();
+    }
+    amm::bench::generateFixtures(options, root);
+
+    // Icon theme and desktop file lookups go only to the generated tree
+    setenv("HOME", (root + "/home").c_str(), 1);
+    setenv("XDG_DATA_HOME", (root + "/home/.local/share").c_str(), 1);
+    setenv("XDG_DATA_DIRS", (root + "/share").c_str(), 1);
+
+    std::vector<amm::bench::Stage> stages;
+    for (size_t i = 0; i < options.repetitions; ++i) {
+        amm::bench::runOnce(options, root, &stages);
+    }
+    amm::bench::report(options, stages);
+
+    if (is_temporary) {
+        amm::bench::removeFixtures(root);
+    }
+    return 0;
+}
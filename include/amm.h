@@ -25,12 +25,15 @@
 #include "amm_options.h"
 #include "system_environment.h"
 #include "menu.h"
+#include "trace.h"
 #include "icon_search/icon_search_interface.h"
+#include "icon_search/xdg_search.h"
 
 namespace amm {
 class Amm
 {
 public:
+    Amm() : is_trace_saved_(false), is_output_unchanged_(false), xdg_searcher_(nullptr) { }
     void validateEnvironment() const;
     void loadCommandLineOption(int argc, char **argv);
     void registerIconService();
@@ -39,11 +42,25 @@ public:
     void populate();
     void writeOutputFile();
     void printSummary() const;
+    void writeTrace();
+    void watch();
 
 private:
+    std::string fileContent() const;
+    bool replaceOutputFile(bool is_backed_up);
+    void refreshIconService();
+    Trace* activeTrace();
+
     SystemEnvironment environment_;
     AmmOptions options_;
+    Trace trace_;
+    bool is_trace_saved_;
+    bool is_output_unchanged_;
     Menu menu_;
+    // Owned by the menu's icon service; kept to tell when installed icons have changed
+    const icon_search::XdgSearch *xdg_searcher_;
+    std::string icon_cache_key_;
+    std::vector<std::string> desktop_entry_directory_names_;
     std::vector<std::string> desktop_entry_file_names_;
 };
 } // namespace amm
@@ -32,6 +32,7 @@ struct AmmOptions
     bool is_help;
     bool is_version;
     bool is_iconize;
+    bool is_watch;
     bool override_default_directories;
     std::string summary_type;
     std::string output_file_name;
@@ -39,6 +40,8 @@ struct AmmOptions
     std::string category_file_name;
     std::string icon_theme_name;
     std::string language;
+    std::string trace_file_name;
+    int jobs;
     std::vector<std::string> deprecations;
 
     bool hasValidSummaryType() const { return (summary_type == "normal" || summary_type == "long"); }
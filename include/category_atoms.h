@@ -0,0 +1,73 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_CATEGORY_ATOMS_H_
+#define AMM_CATEGORY_ATOMS_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "line_view.h"
+
+namespace amm {
+
+// Understands a set of categories as a bit per category atom
+class CategorySet
+{
+public:
+    bool empty() const;
+    bool contains(size_t atom) const;
+    void insert(size_t atom);
+    // A word-wide AND over the shorter of the two sets
+    bool intersects(const CategorySet &other) const;
+    // Visits the atoms in increasing order, skipping empty words
+    void eachAtom(const std::function<void(size_t)> &visitor) const;
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+// Understands category names as small integers
+// The registered XDG main and additional categories are numbered in a fixed table; other categories are numbered as they are first seen
+class CategoryAtoms
+{
+public:
+    static size_t registeredCount();
+
+    // Numbers the category if it hasn't been seen yet
+    size_t atom(const std::string &name);
+    // Fails for categories that are neither registered nor seen yet
+    bool find(const std::string &name, size_t *atom) const;
+    // Looks the category up in place, without copying it
+    bool find(const LineView &name, size_t *atom) const;
+    std::string name(size_t atom) const;
+
+    CategorySet internAll(const std::vector<std::string> &names);
+
+private:
+    // Sorted by name, so that they are found by binary search like the registered ones
+    std::vector<std::pair<std::string, size_t>> custom_atoms_;
+    std::vector<std::string> custom_names_;
+};
+
+} // namespace amm
+
+#endif // AMM_CATEGORY_ATOMS_H_
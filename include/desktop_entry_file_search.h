@@ -22,23 +22,31 @@
 #include <string>
 #include <vector>
 
+#include "trace.h"
+
 namespace amm {
 // Understands search for .desktop files
 class DesktopEntryFileSearch
 {
 public:
+    DesktopEntryFileSearch() : trace_(nullptr) { }
     void resolve();
     void registerDirectories(const std::vector<std::string> &directory_names) { directory_names_ = directory_names; }
     void registerDefaultDirectories();
+    // Each directory searched is recorded as a span while a trace is registered
+    void registerTrace(Trace *trace) { trace_ = trace; }
+    std::vector<std::string> directoryNames() const { return directory_names_; }
     std::vector<std::string> desktopEntryFileNames() const { return desktop_file_names_; }
     std::vector<std::string> badPaths() const { return bad_paths_; }
 
 private:
     void populate(const std::string &directory_name);
+    void populate(int descriptor, std::string *path);
 
     std::vector<std::string> directory_names_;
     std::vector<std::string> desktop_file_names_;
     std::vector<std::string> bad_paths_;
+    Trace *trace_;
 };
 } // namespace amm
 
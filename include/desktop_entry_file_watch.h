@@ -0,0 +1,60 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_DESKTOP_ENTRY_FILE_WATCH_H_
+#define AMM_DESKTOP_ENTRY_FILE_WATCH_H_
+
+#include <csignal>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace amm {
+// Understands changes to .desktop files in directories, as notified by inotify
+class DesktopEntryFileWatch
+{
+public:
+    DesktopEntryFileWatch();
+    ~DesktopEntryFileWatch();
+    DesktopEntryFileWatch(const DesktopEntryFileWatch&) = delete;
+    DesktopEntryFileWatch& operator=(const DesktopEntryFileWatch&) = delete;
+
+    bool isValid() const { return descriptor_ >= 0; }
+    void registerDirectories(const std::vector<std::string> &directory_names);
+    std::vector<std::string> watchedDirectoryNames() const;
+    // wait() replaces the signal mask with this one while it blocks, as ppoll does
+    // A caller that blocks its stop signals and unblocks them here can't miss one that arrives just before wait()
+    void registerWaitSignalMask(const sigset_t &signal_mask);
+
+    // Blocks until desktop files change, gathering changes that follow within the settle time
+    // Adding or removing directories can't be narrowed down to files, so it asks for a rescan
+    // Returns false when interrupted by a signal
+    bool wait(std::vector<std::string> *file_names, bool *is_rescan_needed, int settle_milliseconds = 200);
+
+private:
+    void watch(const std::string &directory_name);
+    bool readEvents(std::vector<std::string> *file_names, bool *is_rescan_needed);
+
+    int descriptor_;
+    std::map<int, std::string> directory_names_;
+    sigset_t wait_signal_mask_;
+    bool has_wait_signal_mask_;
+};
+} // namespace amm
+
+#endif // AMM_DESKTOP_ENTRY_FILE_WATCH_H_
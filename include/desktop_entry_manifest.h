@@ -0,0 +1,63 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_DESKTOP_ENTRY_MANIFEST_H_
+#define AMM_DESKTOP_ENTRY_MANIFEST_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "xdg/desktop_entry.h"
+
+namespace amm {
+// Understands desktop files parsed in earlier runs, stored in a manifest file
+// A desktop file is reused only while its modification time and size are unchanged
+// The manifest file is discarded when it was written for another language or by another revision of the parser
+class DesktopEntryManifest
+{
+public:
+    DesktopEntryManifest(const std::string &file_name, const std::string &language);
+    ~DesktopEntryManifest();
+
+    bool find(const std::string &desktop_file_name, long long modification_time, long long size, xdg::DesktopEntry *entry) const;
+    void add(const std::string &desktop_file_name, long long modification_time, long long size, const xdg::DesktopEntry &entry);
+    void remove(const std::string &desktop_file_name);
+    void retainOnly(const std::vector<std::string> &desktop_file_names);
+    size_t size() const { return records_.size(); }
+    bool save() const;
+
+private:
+    struct Record
+    {
+        long long modification_time;
+        long long size;
+        xdg::DesktopEntry entry;
+    };
+
+    std::string header() const;
+    void load();
+
+    std::string file_name_;
+    std::string language_;
+    std::unordered_map<std::string, Record> records_;
+    mutable bool is_dirty_;
+};
+} // namespace amm
+
+#endif // AMM_DESKTOP_ENTRY_MANIFEST_H_
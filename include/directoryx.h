@@ -30,6 +30,7 @@ class DirectoryX
 public:
     explicit DirectoryX(const std::string &path) : path_(path) {}
     bool isValid() const;
+    bool create() const;
 
     class Entries
     {
@@ -28,10 +28,17 @@ class FileX
 public:
     explicit FileX(const std::string &name) : name_(name) { }
     bool readLines(std::vector<std::string> *lines) const;
+    // Reads the whole file into a single buffer, to be walked with a LineScanner
+    bool readAll(std::string *content) const;
     bool writeLines(const std::vector<std::string> &lines) const;
+    // Writes the content with as few write() calls as the system allows; fails if the file exists
+    bool writeAll(const std::string &content) const;
     bool moveTo(const std::string &location) const;
     bool exists() const;
     bool existsAsDirectory() const;
+    long modificationTime() const;
+    // Modification time is in nanoseconds, so that changes within the same second are told apart
+    bool status(long long *modification_time, long long *size) const;
 
 private:
     std::string name_;
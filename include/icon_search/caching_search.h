@@ -19,36 +19,57 @@
 #ifndef AMM_ICON_SEARCH_CACHING_SEARCH_H_
 #define AMM_ICON_SEARCH_CACHING_SEARCH_H_
 
+#include <array>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "icon_search_interface.h"
 
 namespace amm {
 namespace icon_search {
 // Understands reusing older searches for icon names
+// Safe to call from several threads: names are spread over independently locked shards, and a name
+// asked for while it is being searched waits for that search instead of searching again
+// The underlying searcher may be called concurrently for different names
+// An exception from the underlying searcher reaches the caller that started the search; its waiters search again
 class CachingSearch : public IconSearchInterface
 {
 public:
     explicit CachingSearch(IconSearchInterface *actual_searcher) : actual_searcher_(std::unique_ptr<icon_search::IconSearchInterface>{actual_searcher}) { }
-    std::string resolvedName(const std::string &icon_name) const
-    {
-        auto it = IteratorTo(icon_name);
-        if (it != cache.end()) {
-            return it->second;
-        }
-        auto result = actual_searcher_->resolvedName(icon_name);
-        cache.insert(std::pair<std::string, std::string>(icon_name, result));
-        return result;
-    }
+    std::string resolvedName(const std::string &icon_name) const;
+    // Names not cached and not being searched are searched together in one call to the underlying searcher
+    std::vector<std::string> resolveAll(const std::vector<std::string> &icon_names) const;
 
-    bool isCached(const std::string &icon_name) const { return IteratorTo(icon_name) != cache.end(); }
+    bool isCached(const std::string &icon_name) const;
 
 private:
+    struct Entry
+    {
+        Entry() : is_resolved(false) { }
+        bool is_resolved;
+        std::string resolved_name;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::condition_variable resolved;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    static const size_t kShardCount = 16;
+
+    Shard& shardFor(const std::string &icon_name) const;
+    void store(const std::string &icon_name, const std::string &resolved_name) const;
+    void abandon(const std::vector<std::string> &icon_names) const;
+    bool waitFor(const std::string &icon_name, std::unique_lock<std::mutex> *lock, std::string *resolved_name) const;
+
     std::unique_ptr<icon_search::IconSearchInterface> actual_searcher_;
-    mutable std::map<std::string, std::string> cache;
-    std::map<std::string, std::string>::const_iterator IteratorTo(const std::string &icon_name) const { return cache.find(icon_name); }
+    mutable std::array<Shard, kShardCount> shards_;
 };
 
 } // namespace icon_search
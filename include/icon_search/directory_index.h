@@ -0,0 +1,57 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_ICON_SEARCH_DIRECTORY_INDEX_H_
+#define AMM_ICON_SEARCH_DIRECTORY_INDEX_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace amm {
+namespace icon_search {
+// Understands the icon files present in directories, reading each directory only once
+// Safe to call from several threads
+class DirectoryIndex
+{
+public:
+    explicit DirectoryIndex(const std::vector<std::string> &registered_extensions) : registered_extensions_(registered_extensions) { }
+
+    std::vector<std::string> fileNames(const std::string &directory_name, const std::string &icon_name) const;
+    // Calls found(i, file_name) for each registered extension that icon_names[i] is present with
+    // The directory's listing is looked up once for all the names
+    void eachFileName(const std::string &directory_name, const std::vector<std::string> &icon_names,
+                      const std::function<void(size_t, const std::string&)> &found) const;
+    bool isIndexed(const std::string &directory_name) const;
+
+private:
+    // Maps file names without extension to a bit-mask of the registered extensions present
+    typedef std::unordered_map<std::string, unsigned int> Listing;
+
+    const Listing& listing(const std::string &directory_name) const;
+
+    std::vector<std::string> registered_extensions_;
+    mutable std::unordered_map<std::string, Listing> listings_;
+    mutable std::mutex mutex_;
+};
+} // namespace icon_search
+} // namespace amm
+
+#endif // AMM_ICON_SEARCH_DIRECTORY_INDEX_H_
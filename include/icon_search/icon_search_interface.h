@@ -29,6 +29,17 @@ class IconSearchInterface
 public:
     virtual ~IconSearchInterface() {}
     virtual std::string resolvedName(const std::string &icon_name) const = 0;
+
+    // Resolves several names at once, in the order given, so that a search can share work between them
+    virtual std::vector<std::string> resolveAll(const std::vector<std::string> &icon_names) const
+    {
+        std::vector<std::string> resolved_names;
+        resolved_names.reserve(icon_names.size());
+        for (const auto &icon_name : icon_names) {
+            resolved_names.push_back(resolvedName(icon_name));
+        }
+        return resolved_names;
+    }
 };
 } // namespace icon_search
 } // namespace amm
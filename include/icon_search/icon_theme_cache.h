@@ -0,0 +1,64 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_ICON_SEARCH_ICON_THEME_CACHE_H_
+#define AMM_ICON_SEARCH_ICON_THEME_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace amm {
+namespace icon_search {
+// Understands icon-theme.cache, GTK's hash table from icon names to the sub-directories of a theme that have them
+// The cache is used only when it is newer than its theme directory
+class IconThemeCache
+{
+public:
+    IconThemeCache(const std::string &theme_directory_name, const std::vector<std::string> &registered_extensions);
+    ~IconThemeCache();
+    IconThemeCache(const IconThemeCache&) = delete;
+    IconThemeCache& operator=(const IconThemeCache&) = delete;
+
+    bool isValid() const { return data_ != nullptr; }
+    bool hasSubdirectory(const std::string &subdirectory_name) const;
+    std::vector<std::string> fileNames(const std::string &directory_name, const std::string &subdirectory_name, const std::string &icon_name) const;
+    // Calls found(i, file_name) for each registered extension that icon_names[i] has in the sub-directory
+    void eachFileName(const std::string &directory_name, const std::string &subdirectory_name, const std::vector<std::string> &icon_names,
+                      const std::function<void(size_t, const std::string&)> &found) const;
+
+private:
+    bool map(const std::string &file_name);
+    bool indexSubdirectories();
+    bool read16(uint32_t offset, uint16_t *value) const;
+    bool read32(uint32_t offset, uint32_t *value) const;
+    const char *stringAt(uint32_t offset) const;
+    uint32_t imageListOffset(const std::string &icon_name) const;
+    void unmap();
+
+    std::vector<std::string> registered_extensions_;
+    const unsigned char *data_;
+    size_t size_;
+    std::unordered_map<std::string, uint16_t> subdirectory_indices_;
+};
+} // namespace icon_search
+} // namespace amm
+
+#endif // AMM_ICON_SEARCH_ICON_THEME_CACHE_H_
@@ -31,6 +31,7 @@ class MirrorSearch : public IconSearchInterface
 {
 public:
     std::string resolvedName(const std::string &icon_name) const { return icon_name; }
+    std::vector<std::string> resolveAll(const std::vector<std::string> &icon_names) const { return icon_names; }
 };
 } // namespace icon_search
 } // namespace amm
@@ -0,0 +1,60 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_ICON_SEARCH_PERSISTENT_SEARCH_H_
+#define AMM_ICON_SEARCH_PERSISTENT_SEARCH_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "icon_search_interface.h"
+
+namespace amm {
+namespace icon_search {
+// Understands reusing icon searches from earlier runs, stored in a cache file
+// The cache file is discarded when its key doesn't match the supplied key
+// Safe to call from several threads; the underlying searcher is called without holding the lock
+class PersistentSearch : public IconSearchInterface
+{
+public:
+    PersistentSearch(IconSearchInterface *actual_searcher, const std::string &file_name, const std::string &key);
+    ~PersistentSearch();
+    std::string resolvedName(const std::string &icon_name) const;
+    std::vector<std::string> resolveAll(const std::vector<std::string> &icon_names) const;
+
+    bool isCached(const std::string &icon_name) const;
+    bool save() const;
+
+private:
+    void load();
+
+    std::unique_ptr<icon_search::IconSearchInterface> actual_searcher_;
+    std::string file_name_;
+    std::string key_;
+    mutable std::map<std::string, std::string> cache_;
+    mutable bool is_dirty_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace icon_search
+} // namespace amm
+
+#endif // AMM_ICON_SEARCH_PERSISTENT_SEARCH_H_
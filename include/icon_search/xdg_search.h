@@ -19,11 +19,15 @@
 #ifndef AMM_ICON_SEARCH_XDG_SEARCH_H_
 #define AMM_ICON_SEARCH_XDG_SEARCH_H_
 
+#include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #include "xdg/icon_theme.h"
 #include "icon_search/icon_search_interface.h"
+#include "icon_search/directory_index.h"
+#include "icon_search/icon_theme_cache.h"
 #include "qualified_icon_theme.h"
 
 namespace amm {
@@ -35,17 +39,30 @@ class XdgSearch : public IconSearchInterface
 public:
     XdgSearch(int size, QualifiedIconTheme qualified_icon_theme);
     std::string resolvedName(const std::string &icon_name) const;
+    std::vector<std::string> resolveAll(const std::vector<std::string> &icon_names) const;
+    std::string cacheKey() const;
+
+    // A theme sub-directory under one search path, ranked by how well it fits the requested size
+    struct PlanEntry
+    {
+        std::string directory_name;
+        std::string subdirectory_name;
+        const IconThemeCache *cache;
+        bool is_match;
+        int distance;
+    };
 
 private:
     int size_;
     std::vector<std::string> registered_extensions_;
     std::vector<std::string> theme_search_paths_;
     std::vector<xdg::IconTheme> icon_themes_;
+    DirectoryIndex directory_index_;
+    std::unordered_map<std::string, std::unique_ptr<IconThemeCache>> theme_caches_;
+    // Lists of sub-directories per theme in lineage order, first for menu icons and then for the rest, fixed at construction
+    std::vector<std::vector<PlanEntry>> search_plan_;
 
-    std::vector<xdg::IconSubdirectory> findSearchLocations(const std::string &icon_name) const;
-    std::string nameInTheme(const std::string &icon_name) const;
-    std::string lookupBySize(const std::vector<xdg::IconSubdirectory> &search_locations) const;
-    std::string fallbackName(const std::string &icon_name) const;
+    void planSearch();
 };
 } // namespace icon_search
 } // namespace amm
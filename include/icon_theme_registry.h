@@ -0,0 +1,55 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_ICON_THEME_REGISTRY_H_
+#define AMM_ICON_THEME_REGISTRY_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "xdg/icon_theme.h"
+
+namespace amm {
+
+// Understands the icon-themes installed under a set of search paths, reading each index.theme only once
+class IconThemeRegistry
+{
+public:
+    explicit IconThemeRegistry(const std::vector<std::string> &theme_search_paths);
+
+    size_t size() const { return themes_.size(); }
+    bool isInstalled(const std::string &theme_name) const { return index_.find(theme_name) != index_.end(); }
+    // The theme followed by all of its ancestors, depth-first in Inherits order, ending with hicolor
+    // Each installed theme appears once, even if inherited along several paths or in a cycle
+    std::vector<xdg::IconTheme> themeWithAncestors(const std::string &theme_name) const;
+
+private:
+    void collect(const std::string &theme_name, std::vector<bool> *visited, std::unordered_set<std::string> *missing,
+                 std::vector<size_t> *lineage) const;
+
+    std::vector<xdg::IconTheme> themes_;
+    // Maps both the name and the directory name of a theme to its position; the first search path wins
+    std::unordered_map<std::string, size_t> index_;
+    mutable std::unordered_map<std::string, std::vector<size_t>> lineages_;
+};
+
+} // namespace amm
+
+#endif // AMM_ICON_THEME_REGISTRY_H_
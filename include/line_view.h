@@ -0,0 +1,65 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_LINE_VIEW_H_
+#define AMM_LINE_VIEW_H_
+
+#include <string>
+
+namespace amm {
+// Understands a range of characters within a buffer, such as a line of a file, without copying it
+class LineView
+{
+public:
+    LineView() : begin_(nullptr), end_(nullptr) { }
+    LineView(const char *begin, const char *end) : begin_(begin), end_(end) { }
+
+    const char *begin() const { return begin_; }
+    const char *end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    std::string str() const { return std::string(begin_, end_); }
+
+    bool is(const char *text, size_t length) const;
+    bool startsWith(const char *text, size_t length) const;
+    const char *find(char c) const;
+    LineView trim() const;
+    // Reverses StringX::escapeField
+    std::string unescapeField() const;
+
+private:
+    const char *begin_;
+    const char *end_;
+};
+
+// Understands splitting a buffer into lines in place
+class LineScanner
+{
+public:
+    LineScanner(const char *begin, const char *end) : next_(begin), end_(end) { }
+    explicit LineScanner(const std::string &content) : next_(content.data()), end_(content.data() + content.size()) { }
+
+    bool next(LineView *line);
+
+private:
+    const char *next_;
+    const char *end_;
+};
+} // namespace amm
+
+#endif // AMM_LINE_VIEW_H_
@@ -19,14 +19,20 @@
 #ifndef AMM_MENU_H_
 #define AMM_MENU_H_
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "category_atoms.h"
 #include "stats.h"
 #include "subcategory.h"
+#include "desktop_entry_manifest.h"
+#include "trace.h"
 #include "icon_search/icon_search_interface.h"
 #include "representation/representation_interface.h"
+#include "transformer/transformer_interface.h"
 
 namespace amm {
 // Understands a collection of desktop files divided in subcategories
@@ -38,24 +44,51 @@ public:
 
     void registerIconService(icon_search::IconSearchInterface *icon_searcher);
     void registerLanguage(const std::string &language) { language_ = language; }
+    // Desktop files are read, and icons searched, on up to this many threads
+    // The icon service must then be safe to call from several threads for different names
+    void registerJobs(size_t jobs) { jobs_ = jobs; }
+    void registerManifest(DesktopEntryManifest *manifest) { manifest_.reset(manifest); }
+    // Desktop file reads and batches of icon searches are recorded as spans while a trace is registered
+    void registerTrace(Trace *trace) { trace_ = trace; }
     std::vector<Subcategory> subcategories() const { return subcategories_; }
     Stats summary() const { return summary_; }
 
     void loadCustomCategories(const std::vector<std::string> &lines);
     void populate(const std::vector<std::string> &desktop_file_names);
+    void refresh(const std::vector<std::string> &desktop_file_names);
     void sort();
     std::vector<std::unique_ptr<representation::RepresentationInterface>> representations() const;
+    // Appends the menu to the output, one line per representation
+    void transform(const transformer::TransformerInterface &transformer, std::string *output) const;
 
 private:
-    void addDesktopEntry(const std::string &desktop_entry_name);
-    bool classify(const xdg::DesktopEntry &entry);
+    bool readDesktopEntry(const std::string &desktop_entry_name, xdg::DesktopEntry *entry) const;
+    void recordInManifest(const std::string &desktop_entry_name, bool is_read, long long modification_time, long long size, const xdg::DesktopEntry &entry);
+    void addDesktopEntry(size_t index);
+    void classifyDesktopEntries();
+    bool classify(size_t index);
+    std::unordered_map<std::string, std::string> resolvedIconNames() const;
+    void eachRepresentation(const std::function<void(std::unique_ptr<representation::RepresentationInterface>)> &visitor) const;
     void createDefaultCategories();
+    void indexSubcategories();
 
     std::string language_;
+    size_t jobs_;
     std::unique_ptr<icon_search::IconSearchInterface> icon_searcher_;
+    std::unique_ptr<DesktopEntryManifest> manifest_;
+    Trace *trace_;
+    size_t manifest_hits_;
+    size_t manifest_misses_;
     Subcategory unclassified_subcategory_;
     std::vector<Subcategory> subcategories_;
+    bool has_unclassified_subcategory_;
+    CategoryAtoms category_atoms_;
+    // The positions of the subcategories that accept each category atom, in menu order
+    std::vector<std::vector<size_t>> subcategories_by_atom_;
     std::vector<std::string> desktop_file_names_;
+    // The pool of desktop entries, in the same order as their file names
+    std::vector<xdg::DesktopEntry> desktop_entries_;
+    std::vector<char> are_read_;
     Stats summary_;
 };
 } // namespace amm
@@ -36,7 +36,13 @@ std::string noValidDesktopEntryFiles();
 std::string badCategoryFile(const std::string &file_name);
 std::string outputPathBlockedByDirectory(const std::string &file_name);
 std::string badOutputFile(const std::string &file_name);
+std::string badTraceFile(const std::string &file_name);
+std::string unchangedOutputFile(const std::string &file_name);
 std::string backupFile(const std::string &file_name, const std::string &backup_file_name);
+std::string badBackupFile(const std::string &backup_file_name);
+std::string watchUnavailable();
+std::string watching(const std::string &directory_names);
+std::string updatedOutputFile(const std::string &file_name, size_t changed_file_count);
 
 } // namespace messages
 } // namespace amm
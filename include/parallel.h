@@ -16,32 +16,18 @@
   along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#ifndef AMM_XDG_ENTRY_LINE_H_
-#define AMM_XDG_ENTRY_LINE_H_
+#ifndef AMM_PARALLEL_H_
+#define AMM_PARALLEL_H_
 
-#include <string>
+#include <cstddef>
+#include <functional>
 
 namespace amm {
-namespace xdg {
-
-// Understands a line of XDG style INI files
-class EntryLine
-{
-public:
-    explicit EntryLine(const std::string &content);
-    bool isDeclaration() const;
-    bool isAssignment() const;
-    std::string declaration() const;
-    std::string key() const;
-    std::string value() const;
-
-private:
-    std::string content_;
-    size_t content_length_;
-    size_t assignment_delim_location_;
-};
-
-} // namespace xdg
+namespace parallel {
+// Runs task(0) ... task(count - 1) on up to the given number of worker threads
+// Each index is handed to exactly one worker; the call returns after every task has finished
+void forEach(size_t count, size_t jobs, const std::function<void(size_t)> &task);
+} // namespace parallel
 } // namespace amm
 
-#endif //AMM_XDG_ENTRY_LINE_H_
+#endif // AMM_PARALLEL_H_
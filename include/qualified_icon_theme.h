@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "icon_theme_registry.h"
 #include "system_environment.h"
 #include "xdg/icon_theme.h"
 
@@ -33,13 +34,12 @@ class QualifiedIconTheme
 public:
     QualifiedIconTheme(const SystemEnvironment &environment, const std::string &theme_name);
     std::vector<std::string> themeSearchPaths() { return theme_search_paths_; }
-    std::vector<xdg::IconTheme> themeWithParent();
+    std::vector<xdg::IconTheme> themeWithAncestors() const { return registry_.themeWithAncestors(theme_name_); }
 
 private:
     std::string theme_name_;
     std::vector<std::string> theme_search_paths_;
-    xdg::IconTheme currentIconThemeFromName();
-    xdg::IconTheme iconThemeFromName(const std::string &theme_name);
+    IconThemeRegistry registry_;
 };
 
 }
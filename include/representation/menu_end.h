@@ -33,6 +33,7 @@ public:
     virtual ~MenuEnd() {}
     virtual std::string name() const { return "Menu end"; }
     virtual std::string visit(const transformer::TransformerInterface &transformer) const { return transformer.transform(*this); }
+    virtual void visit(const transformer::TransformerInterface &transformer, std::string *output) const { transformer.transform(*this, output); }
 };
 
 } // namespace representation
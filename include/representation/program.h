@@ -38,6 +38,7 @@ public:
     virtual std::string executable() const { return executable_; }
     virtual std::string comment() const { return comment_; }
     virtual std::string visit(const transformer::TransformerInterface &transformer) const { return transformer.transform(*this); }
+    virtual void visit(const transformer::TransformerInterface &transformer, std::string *output) const { transformer.transform(*this, output); }
 private:
     const std::string name_;
     const std::string icon_;
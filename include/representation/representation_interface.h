@@ -31,6 +31,7 @@ public:
     virtual ~RepresentationInterface() {}
     virtual std::string name() const = 0;
     virtual std::string visit(const transformer::TransformerInterface &transformer) const = 0;
+    virtual void visit(const transformer::TransformerInterface &transformer, std::string *output) const = 0;
 };
 
 } // namespace representation
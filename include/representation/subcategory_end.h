@@ -34,6 +34,7 @@ public:
     virtual ~SubcategoryEnd() {}
     virtual std::string name() const { return name_ + " end"; }
     virtual std::string visit(const transformer::TransformerInterface &transformer) const { return transformer.transform(*this); }
+    virtual void visit(const transformer::TransformerInterface &transformer, std::string *output) const { transformer.transform(*this, output); }
 private:
     const std::string name_;
 };
@@ -35,6 +35,7 @@ public:
     virtual std::string name() const { return name_; }
     virtual std::string icon() const { return icon_; }
     virtual std::string visit(const transformer::TransformerInterface &transformer) const { return transformer.transform(*this); }
+    virtual void visit(const transformer::TransformerInterface &transformer, std::string *output) const { transformer.transform(*this, output); }
 private:
     const std::string name_;
     const std::string icon_;
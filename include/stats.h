@@ -27,17 +27,23 @@ namespace amm {
 class Stats
 {
 public:
+    Stats() : manifest_hits_(0), manifest_misses_(0) { }
+
     void addClassifiedFile(const std::string &file) { classified_files_.push_back(file); }
     void addUnclassifiedFile(const std::string &file) { unclassified_files_.push_back(file); }
     void addSuppressedFile(const std::string &file) { suppressed_files_.push_back(file); }
     void addUnparsedFile(const std::string &file) { unparsed_files_.push_back(file); }
     void addUnhandledClassifications(const std::vector<std::string> &classifications);
+    void addManifestHits(size_t count) { manifest_hits_ += count; }
+    void addManifestMisses(size_t count) { manifest_misses_ += count; }
 
     size_t totalFiles() const;
     size_t totalParsedFiles() const;
     size_t totalUnclassifiedFiles() const;
     size_t totalSuppressedFiles() const;
     size_t totalUnparsedFiles() const;
+    size_t manifestHits() const { return manifest_hits_; }
+    size_t manifestMisses() const { return manifest_misses_; }
     std::vector<std::string> unparsedFiles() const;
     std::vector<std::string> unhandledClassifications();
 
@@ -49,6 +55,8 @@ private:
     std::vector<std::string> unparsed_files_;
     std::vector<std::string> suppressed_files_;
     std::vector<std::string> unhandled_classifications_;
+    size_t manifest_hits_;
+    size_t manifest_misses_;
 };
 } // namespace amm
 
@@ -31,7 +31,12 @@ public:
     bool endsWith(const std::string &delimiter) const;
     std::string terminateWith(const std::string &end) const;
     std::string encode() const;
+    // Escapes backslashes, tabs and newlines, so that the string fits in one tab-separated field of a line
+    std::string escapeField() const;
     std::string trim() const;
+    std::string digest() const;
+    // Byte-wise comparison of keys orders strings as the current LC_COLLATE locale does
+    std::string collationKey() const;
     std::vector<std::string> split(const std::string &delimiter) const;
 private:
     const std::string string_;
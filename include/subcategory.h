@@ -21,6 +21,8 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <utility>
 
 #include "xdg/desktop_entry.h"
 
@@ -29,17 +31,26 @@ namespace amm {
 class Subcategory
 {
 public:
-    Subcategory() {}
+    Subcategory() : pool_(nullptr) {}
     Subcategory(const std::string &display_name, const std::string &icon_name, const std::string &classification_name);
     Subcategory(const std::string &display_name, const std::string &icon_name, const std::vector<std::string> &classification_names);
 
     std::string displayName() const { return display_name_; }
     std::string iconName() const { return icon_name_; }
     std::vector<std::string> classificationNames() const { return classification_names_; }
-    std::vector<xdg::DesktopEntry> desktopEntries() const { return desktop_entries_; }
+    // Entries are held as positions in a pool of desktop entries, shared by every subcategory of a menu
+    // The pool must be set before any entry is added
+    void drawsFrom(const std::vector<xdg::DesktopEntry> *pool) { pool_ = pool; }
+    const std::vector<size_t>& desktopEntryIndices() const { return desktop_entry_indices_; }
+    std::vector<xdg::DesktopEntry> desktopEntries() const;
 
-    bool hasEntries() const;
-    void addDesktopEntry(const xdg::DesktopEntry &desktop_file);
+    bool hasEntries() const { return !desktop_entry_indices_.empty(); }
+    // An entry equal to one added earlier is left out, so the first desktop file found for an application wins
+    void addDesktopEntry(size_t index);
+    void clearDesktopEntries() { desktop_entry_indices_.clear(); indices_by_hash_.clear(); }
+    // Sorts by the collation keys of the entries' names, given for the whole pool, and then by position
+    void sortDesktopEntries(const std::vector<std::string> &collation_keys);
+    // Sorts the same way, computing keys for its own entries only
     void sortDesktopEntries();
 
     static Subcategory Others()      { return Subcategory("Others",      "applications-others",      "Others"     ); }
@@ -56,10 +67,17 @@ public:
     static Subcategory System()      { return Subcategory("System",      "applications-system",      "System"     ); }
 
 private:
+    // A collation key and the position of the entry it belongs to
+    typedef std::pair<const std::string*, size_t> KeyedIndex;
+
+    void sortKeyed(std::vector<KeyedIndex> *keyed_indices);
+
     std::string display_name_;
     std::string icon_name_;
     std::vector<std::string> classification_names_;
-    std::vector<xdg::DesktopEntry> desktop_entries_;
+    const std::vector<xdg::DesktopEntry> *pool_;
+    std::vector<size_t> desktop_entry_indices_;
+    std::unordered_multimap<size_t, size_t> indices_by_hash_;
 };
 } // namespace amm
 
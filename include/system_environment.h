@@ -32,6 +32,7 @@ public:
     std::string home() const { return home_; }
     std::string xdgDataHome() const { return xdg_data_home_; }
     std::vector<std::string> xdgDataDirectories() const;
+    std::string xdgCacheHome() const { return xdg_cache_home_; }
     std::string language() const { return language_; }
     std::vector<std::string> applicationDirectories() const;
     std::vector<std::string> iconThemeDirectories() const;
@@ -40,6 +41,7 @@ private:
     std::string home_;
     std::string xdg_data_home_;
     std::string xdg_data_dirs_;
+    std::string xdg_cache_home_;
     std::string language_;
 
     std::string getLanguageWith(const char *raw);
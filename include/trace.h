@@ -0,0 +1,81 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMM_TRACE_H_
+#define AMM_TRACE_H_
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace amm {
+// Understands timed spans of a run, exported as Chrome trace events
+// Spans may be recorded from any thread
+class Trace
+{
+public:
+    // Records the time from its construction to its destruction
+    // A span on a null trace records nothing
+    class Span
+    {
+    public:
+        Span(Trace *trace, const std::string &name, const std::string &category);
+        ~Span();
+        void annotate(const std::string &key, const std::string &value);
+
+    private:
+        Span(const Span &) = delete;
+        Span& operator=(const Span &) = delete;
+
+        Trace *trace_;
+        std::string name_;
+        std::string category_;
+        std::vector<std::pair<std::string, std::string>> arguments_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    Trace() : origin_(std::chrono::steady_clock::now()) { }
+    size_t size() const;
+    std::string json() const;
+    bool save(const std::string &file_name) const;
+
+private:
+    struct Event
+    {
+        std::string name;
+        std::string category;
+        std::vector<std::pair<std::string, std::string>> arguments;
+        double start_us;
+        double duration_us;
+        int thread;
+    };
+
+    void record(Event event, std::thread::id thread_id);
+
+    std::chrono::steady_clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+    std::map<std::thread::id, int> threads_;
+};
+} // namespace amm
+
+#endif // AMM_TRACE_H_
@@ -39,6 +39,12 @@ public:
     virtual std::string transform(const representation::SubcategoryStart &entry) const;
     virtual std::string transform(const representation::SubcategoryEnd &entry) const;
     virtual std::string transform(const representation::Program &entry) const;
+
+    virtual void transform(const representation::MenuStart &entry, std::string *output) const;
+    virtual void transform(const representation::MenuEnd &entry, std::string *output) const;
+    virtual void transform(const representation::SubcategoryStart &entry, std::string *output) const;
+    virtual void transform(const representation::SubcategoryEnd &entry, std::string *output) const;
+    virtual void transform(const representation::Program &entry, std::string *output) const;
 };
 } // namespace transformer
 } // namespace amm
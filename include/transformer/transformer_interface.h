@@ -40,6 +40,14 @@ public:
     virtual std::string transform(const representation::SubcategoryStart &entry) const = 0;
     virtual std::string transform(const representation::SubcategoryEnd &entry) const = 0;
     virtual std::string transform(const representation::Program &entry) const = 0;
+
+    // Append the transformed entry to the output, so that a whole menu is built in one buffer
+    // Transformers that don't override these append the strings returned above
+    virtual void transform(const representation::MenuStart &entry, std::string *output) const { output->append(transform(entry)); }
+    virtual void transform(const representation::MenuEnd &entry, std::string *output) const { output->append(transform(entry)); }
+    virtual void transform(const representation::SubcategoryStart &entry, std::string *output) const { output->append(transform(entry)); }
+    virtual void transform(const representation::SubcategoryEnd &entry, std::string *output) const { output->append(transform(entry)); }
+    virtual void transform(const representation::Program &entry, std::string *output) const { output->append(transform(entry)); }
 };
 } // namespace transformer
 } // namespace amm
@@ -19,9 +19,13 @@
 #ifndef AMM_DESKTOP_ENTRY_H_
 #define AMM_DESKTOP_ENTRY_H_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
+#include "line_view.h"
+
 namespace amm {
 namespace xdg {
 
@@ -29,14 +33,18 @@ namespace xdg {
 class DesktopEntry
 {
 public:
-    DesktopEntry() : display_(true) { }
+    DesktopEntry();
+    DesktopEntry(const std::string &name, const std::string &icon, const std::string &executable,
+                 const std::vector<std::string> &categories, const std::string &comment, bool display);
 
-    std::string name() const { return name_; }
-    std::string icon() const { return icon_; }
-    std::string executable() const { return executable_; }
-    std::vector<std::string> categories() const { return categories_; }
-    std::string comment() const { return comment_; }
+    std::string name() const { return field(0, icon_at_); }
+    std::string icon() const { return field(icon_at_, executable_at_); }
+    std::string executable() const { return field(executable_at_, comment_at_); }
+    std::vector<std::string> categories() const;
+    std::string comment() const { return field(comment_at_, categories_at_); }
     bool display() const { return display_; }
+    // Visits the categories in sorted order without copying them
+    void eachCategory(const std::function<void(const LineView&)> &visitor) const;
 
     void hasLanguage(const std::string &language) { language_ = language; }
 
@@ -44,18 +52,29 @@ public:
     bool operator > (const DesktopEntry &other) const;
     bool operator == (const DesktopEntry &other) const;
     bool operator != (const DesktopEntry &other) const;
+    // Equal entries have equal hashes
+    size_t identityHash() const;
 
     void parse(const std::vector<std::string> &lines);
+    void parse(const std::string &content);
+    // Scans only the [Desktop Entry] section for the keys in use, without copying lines
+    void parse(const char *begin, const char *end);
     bool isValid() const;
     bool isA(const std::string &type) const;
     bool isAnyOf(const std::vector<std::string> &types) const;
 
 private:
-    std::string name_;
-    std::string executable_;
-    std::string icon_;
-    std::vector<std::string> categories_;
-    std::string comment_;
+    void store(const LineView &name, const LineView &icon, const LineView &executable, const LineView &comment, std::vector<LineView> categories);
+    std::string field(uint32_t begin, uint32_t end) const { return text_.substr(begin, end - begin - 1); }
+    LineView view(uint32_t begin, uint32_t end) const { return LineView(text_.data() + begin, text_.data() + end - 1); }
+
+    // The name, icon, executable, comment and sorted categories are kept back to back in one buffer, each ended by '\0'
+    // They then share one allocation, however many categories there are; only the language is held apart
+    std::string text_;
+    uint32_t icon_at_;
+    uint32_t executable_at_;
+    uint32_t comment_at_;
+    uint32_t categories_at_;
     bool display_;
     std::string language_;
 };
@@ -30,13 +30,14 @@ namespace xdg {
 class Entry
 {
 public:
-    Entry(const std::vector<std::string> &lines, const std::string &language) : lines_(lines), language_(language) { }
-    explicit Entry(const std::vector<std::string> &lines) : lines_(lines) { }
+    Entry(const std::vector<std::string> &lines, const std::string &language);
+    explicit Entry(const std::vector<std::string> &lines);
+    explicit Entry(const std::string &content) : content_(content) { }
     void parse();
     std::string under(const std::string &section_name, const std::string &key_name);
 
 private:
-    std::vector<std::string> lines_;
+    std::string content_;
     std::string language_;
     std::map< std::string, std::map< std::string, std::string > > result_;
 };
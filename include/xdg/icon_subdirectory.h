@@ -46,6 +46,9 @@ public:
     int minSize() const { return min_size_; }
     int threshold() const { return threshold_; }
     std::string location() const { return location_; }
+    std::string context() const { return context_; }
+    // Applications and Categories hold the icons menus use; a sub-directory without a context may hold them too
+    bool holdsMenuIcons() const;
     bool matches(int required_size) const;
     int distance(int required_size) const;
 
@@ -54,6 +57,7 @@ public:
     IconSubdirectory& minSize(const std::string &min_size);
     IconSubdirectory& threshold(const std::string &threshold);
     IconSubdirectory& location(const std::string &location);
+    IconSubdirectory& context(const std::string &context);
 
 private:
     std::string name_;
@@ -63,6 +67,7 @@ private:
     int min_size_;
     int threshold_;
     std::string location_;
+    std::string context_;
 };
 
 } // namespace xdg
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "icon_subdirectory.h"
+#include "entry.h"
 
 namespace amm {
 namespace xdg {
@@ -32,6 +33,7 @@ class IconTheme
 {
 public:
     explicit IconTheme(const std::vector<std::string> &lines);
+    explicit IconTheme(const std::string &content);
 
     std::string name() const { return name_; }
     std::string internalName() const { return internal_name_; }
@@ -41,6 +43,8 @@ public:
     IconTheme internalNameIs(const std::string &internal_name) { internal_name_ = internal_name; return *this; }
 
 private:
+    void populate(Entry *xdg_entry);
+
     std::string name_;
     std::string internal_name_;
     std::vector<std::string> parents_;
@@ -18,15 +18,21 @@
 
 #include "amm.h"
 
+#include <csignal>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <iterator>
 
+#include "stringx.h"
 #include "vectorx.h"
 #include "filex.h"
+#include "directoryx.h"
 #include "timex.h"
 #include "messages.h"
 #include "amm_options.h"
@@ -34,15 +40,33 @@
 #include "command_line_options_parser.h"
 #include "icon_search/icon_search_interface.h"
 #include "icon_search/xdg_search.h"
-#include "icon_search/caching_search.h"
+#include "icon_search/persistent_search.h"
 #include "qualified_icon_theme.h"
 #include "desktop_entry_file_search.h"
+#include "desktop_entry_file_watch.h"
+#include "desktop_entry_manifest.h"
 #include "stats.h"
 #include "menu.h"
 #include "transformer/jwm.h"
 
 namespace amm {
 
+// The icon theme name comes from the command line; '%' and '/' are encoded so that it names a file within the cache directory
+static std::string cacheFileNamePart(const std::string &name)
+{
+    std::string result;
+    for (auto c : name) {
+        if (c == '%') {
+            result += "%25";
+        } else if (c == '/') {
+            result += "%2F";
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
 static inline void displayToSTDOUT(std::string message)
 {
     std::cout << message << std::endl;
@@ -53,6 +77,39 @@ static inline void displayToSTDERR(std::string message)
     std::cerr << message << std::endl;
 }
 
+static volatile sig_atomic_t is_stopped = 0;
+
+static void stop(int)
+{
+    is_stopped = 1;
+}
+
+// Handlers are installed without SA_RESTART so that a blocked watch returns, and the icon cache is saved on the way out
+// The signals stay blocked except while the watch waits, so one that arrives between checks is still noticed
+// Returns the signal mask to wait with
+static sigset_t stopOnSignals()
+{
+    struct sigaction action;
+    action.sa_handler = stop;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGHUP, &action, nullptr);
+
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    sigaddset(&stop_signals, SIGHUP);
+    sigset_t wait_mask;
+    sigprocmask(SIG_BLOCK, &stop_signals, &wait_mask);
+    sigdelset(&wait_mask, SIGINT);
+    sigdelset(&wait_mask, SIGTERM);
+    sigdelset(&wait_mask, SIGHUP);
+    return wait_mask;
+}
+
 void Amm::validateEnvironment() const
 {
     if (!environment_.isValid()) {
@@ -63,6 +120,7 @@ void Amm::validateEnvironment() const
 
 void Amm::loadCommandLineOption(int argc, char **argv)
 {
+    Trace::Span span(&trace_, "loadCommandLineOption", "stage");
     options_ = CommandLineOptionsParser(environment_.home(), environment_.language()).parse(argc, argv);
     auto deprecations = options_.deprecations;
     if (!deprecations.empty()) {
@@ -88,6 +146,7 @@ void Amm::loadCommandLineOption(int argc, char **argv)
 
 void Amm::readCategories()
 {
+    Trace::Span span(activeTrace(), "readCategories", "stage");
     auto category_file_name = options_.category_file_name;
     std::vector<std::string> category_lines;
 
@@ -103,18 +162,42 @@ void Amm::readCategories()
 
 void Amm::registerIconService()
 {
+    Trace::Span span(activeTrace(), "registerIconService", "stage");
     if (options_.is_iconize) {
         QualifiedIconTheme theme(environment_, options_.icon_theme_name);
-        auto caching_xdg_searcher = new icon_search::CachingSearch(new icon_search::XdgSearch(48, theme));
-        menu_.registerIconService(caching_xdg_searcher);
+        auto xdg_searcher = new icon_search::XdgSearch(48, theme);
+        auto cache_directory_name = StringX(environment_.xdgCacheHome()).terminateWith("/") + "amm";
+        DirectoryX(environment_.xdgCacheHome()).create();
+        DirectoryX(cache_directory_name).create();
+        auto cache_file_name = cache_directory_name + "/icons-" + cacheFileNamePart(options_.icon_theme_name) + "-48";
+        xdg_searcher_ = xdg_searcher;
+        icon_cache_key_ = xdg_searcher->cacheKey();
+        auto persistent_xdg_searcher = new icon_search::PersistentSearch(xdg_searcher, cache_file_name, icon_cache_key_);
+        menu_.registerIconService(persistent_xdg_searcher);
+    }
+}
+
+// The icon searcher lists theme directories and plans its search once, and remembers misses
+// A watching run starts it afresh once the themes have changed, so that newly installed icons are found
+void Amm::refreshIconService()
+{
+    if (xdg_searcher_ == nullptr || xdg_searcher_->cacheKey() == icon_cache_key_) {
+        return;
     }
+
+    // The earlier searcher saves its cache before the new one reads it
+    xdg_searcher_ = nullptr;
+    menu_.registerIconService(nullptr);
+    registerIconService();
 }
 
 void Amm::readDesktopEntryFiles()
 {
+    Trace::Span span(activeTrace(), "readDesktopEntryFiles", "stage");
     auto input_directory_names = options_.input_directory_names;
 
     DesktopEntryFileSearch service;
+    service.registerTrace(activeTrace());
     if (options_.override_default_directories) {
         service.registerDirectories(input_directory_names);
     } else {
@@ -126,12 +209,17 @@ void Amm::readDesktopEntryFiles()
     if (!bad_paths.empty()) {
         displayToSTDERR(messages::badInputPaths(VectorX(bad_paths).join(", ")));
     }
+    desktop_entry_directory_names_ = service.directoryNames();
     desktop_entry_file_names_ = service.desktopEntryFileNames();
 }
 
 void Amm::populate()
 {
+    Trace::Span span(activeTrace(), "populate", "stage");
+    menu_.registerTrace(activeTrace());
     menu_.registerLanguage(options_.language);
+    menu_.registerJobs(options_.jobs);
+    menu_.registerManifest(new DesktopEntryManifest(options_.output_file_name + ".manifest", options_.language));
     menu_.populate(desktop_entry_file_names_);
     if (menu_.summary().totalParsedFiles() == 0) {
         displayToSTDERR(messages::noValidDesktopEntryFiles());
@@ -140,39 +228,151 @@ void Amm::populate()
     menu_.sort();
 }
 
-void Amm::writeOutputFile()
+// The whole file is built in one buffer, to be written with a single write()
+// Its first line tells when the file was generated, and the menu starts right after it
+std::string Amm::fileContent() const
 {
     transformer::Jwm jwm_transformer;
-    auto representations = menu_.representations();
-    std::vector<std::string> output;
-
-    output.push_back(messages::autogeneratedByAmm());
-
-    for (const auto &representation : representations) {
-        output.push_back(representation->visit(jwm_transformer));
-    }
+    auto output = messages::autogeneratedByAmm();
+    output.push_back('\n');
+    menu_.transform(jwm_transformer, &output);
+    return output;
+}
 
+void Amm::writeOutputFile()
+{
+    Trace::Span span(activeTrace(), "writeOutputFile", "stage");
     auto output_file_name = options_.output_file_name;
-    auto output_file = FileX(output_file_name);
-    if (output_file.existsAsDirectory()) {
+    if (FileX(output_file_name).existsAsDirectory()) {
         displayToSTDERR(messages::outputPathBlockedByDirectory(output_file_name));
         exit(1);
     }
-    if (output_file.exists()) {
-        auto backup_file_name = output_file_name + "." + timex::currentTimeAsTimestamp() + ".bak";
-        output_file.moveTo(backup_file_name);
-        displayToSTDOUT(messages::backupFile(output_file_name, backup_file_name));
-    }
-    if (!output_file.writeLines(output)) {
+    if (!replaceOutputFile(true)) {
         displayToSTDERR(messages::badOutputFile(options_.output_file_name));
         exit(1);
     }
 }
 
+// An output file with the same menu is left alone, so that it isn't backed up and JWM doesn't reload it
+// Otherwise the new menu is written next to the output file and renamed over it
+// JWM never sees a partially written menu, and the output file is never replaced without the backup asked for
+bool Amm::replaceOutputFile(bool is_backed_up)
+{
+    auto output_file_name = options_.output_file_name;
+    auto content = fileContent();
+    auto menu_start = content.find('\n') + 1;
+    std::string existing_content;
+    is_output_unchanged_ = false;
+    if (FileX(output_file_name).readAll(&existing_content)) {
+        auto header_prefix_size = content.find('(');
+        auto body_start = existing_content.find('\n');
+        if (existing_content.compare(0, header_prefix_size, content, 0, header_prefix_size) == 0 && body_start != std::string::npos &&
+                existing_content.compare(body_start + 1, std::string::npos, content, menu_start, std::string::npos) == 0) {
+            is_output_unchanged_ = true;
+            return true;
+        }
+
+        if (is_backed_up) {
+            // Timestamps are in whole seconds, so a later backup in the same second is numbered
+            auto backup_file_stem = output_file_name + "." + timex::currentTimeAsTimestamp();
+            auto backup_file_name = backup_file_stem + ".bak";
+            for (int count = 1; FileX(backup_file_name).exists(); ++count) {
+                backup_file_name = backup_file_stem + "-" + std::to_string(count) + ".bak";
+            }
+            if (!FileX(backup_file_name).writeAll(existing_content)) {
+                displayToSTDERR(messages::badBackupFile(backup_file_name));
+                exit(1);
+            }
+            displayToSTDOUT(messages::backupFile(output_file_name, backup_file_name));
+        }
+    }
+
+    auto temporary_file_name = output_file_name + ".tmp";
+    remove(temporary_file_name.c_str());
+    if (!FileX(temporary_file_name).writeAll(content)) {
+        return false;
+    }
+    if (!FileX(temporary_file_name).moveTo(output_file_name)) {
+        remove(temporary_file_name.c_str());
+        return false;
+    }
+    return true;
+}
+
 void Amm::printSummary() const
 {
     displayToSTDOUT(menu_.summary().details(options_.summary_type)); // extra line
-    displayToSTDOUT("Created " + options_.output_file_name);
+    if (is_output_unchanged_) {
+        displayToSTDOUT(messages::unchangedOutputFile(options_.output_file_name));
+    } else {
+        displayToSTDOUT("Created " + options_.output_file_name);
+    }
+}
+
+// Only the first build is traced, so that a watching run doesn't grow the trace without bound
+void Amm::writeTrace()
+{
+    if (options_.trace_file_name == "") {
+        return;
+    }
+
+    is_trace_saved_ = true;
+    menu_.registerTrace(nullptr);
+    if (!trace_.save(options_.trace_file_name)) {
+        displayToSTDERR(messages::badTraceFile(options_.trace_file_name));
+    }
+}
+
+Trace* Amm::activeTrace()
+{
+    if (options_.trace_file_name == "" || is_trace_saved_) {
+        return nullptr;
+    }
+    return &trace_;
+}
+
+void Amm::watch()
+{
+    if (!options_.is_watch) {
+        return;
+    }
+
+    DesktopEntryFileWatch file_watch;
+    file_watch.registerDirectories(desktop_entry_directory_names_);
+    auto watched_directory_names = file_watch.watchedDirectoryNames();
+    if (!file_watch.isValid() || watched_directory_names.empty()) {
+        displayToSTDERR(messages::watchUnavailable());
+        exit(1);
+    }
+    file_watch.registerWaitSignalMask(stopOnSignals());
+    displayToSTDOUT(messages::watching(VectorX(watched_directory_names).join(", ")));
+
+    std::vector<std::string> changed_file_names;
+    auto is_rescan_needed = false;
+    while (!is_stopped && file_watch.wait(&changed_file_names, &is_rescan_needed)) {
+        if (is_rescan_needed) {
+            auto known_file_names = desktop_entry_file_names_;
+            readDesktopEntryFiles();
+            auto current_file_names = desktop_entry_file_names_;
+            std::sort(known_file_names.begin(), known_file_names.end());
+            std::sort(current_file_names.begin(), current_file_names.end());
+            std::set_symmetric_difference(known_file_names.begin(), known_file_names.end(),
+                current_file_names.begin(), current_file_names.end(), std::back_inserter(changed_file_names));
+            std::sort(changed_file_names.begin(), changed_file_names.end());
+            changed_file_names.erase(std::unique(changed_file_names.begin(), changed_file_names.end()), changed_file_names.end());
+        }
+
+        menu_.refresh(changed_file_names);
+        menu_.sort();
+        refreshIconService();
+        if (replaceOutputFile(false)) {
+            if (!is_output_unchanged_) {
+                displayToSTDOUT(messages::updatedOutputFile(options_.output_file_name, changed_file_names.size()));
+            }
+        } else {
+            displayToSTDERR(messages::badOutputFile(options_.output_file_name));
+        }
+    }
 }
 
 } // namespace amm
@@ -29,11 +29,13 @@ AmmOptions AmmOptions::Default(const std::string &home, const std::string &langu
     amm_options.is_help = false;
     amm_options.is_version = false;
     amm_options.is_iconize = false;
+    amm_options.is_watch = false;
     amm_options.override_default_directories = false;
     amm_options.summary_type = "normal";
     amm_options.output_file_name = StringX(home).terminateWith("/") + (".jwmrc-amm");
     amm_options.icon_theme_name = "hicolor";
     amm_options.language = language;
+    amm_options.jobs = 1;
     return amm_options;
 }
 } // namespace amm
@@ -0,0 +1,169 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "category_atoms.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "line_view.h"
+
+namespace amm {
+
+// Sorted, so that a name's position is found by binary search and doubles as its atom
+static const char *kRegisteredCategories[] = {
+    "2DGraphics", "3DGraphics", "Accessibility", "ActionGame", "Adult", "AdventureGame", "Amusement", "Applet",
+    "ArcadeGame", "Archiving", "Art", "ArtificialIntelligence", "Astronomy", "Audio", "AudioVideo",
+    "AudioVideoEditing", "Biology", "BlocksGame", "BoardGame", "Building", "Calculator", "Calendar", "CardGame",
+    "Chart", "Chat", "Chemistry", "Clock", "Compression", "ComputerScience", "ConsoleOnly", "Construction",
+    "ContactManagement", "Core", "DDE", "DataVisualization", "Database", "Debugger", "DesktopSettings", "Development",
+    "Dialup", "Dictionary", "DiscBurning", "Documentation", "Economy", "Education", "Electricity", "Electronics",
+    "Email", "Emulator", "Engineering", "Feed", "FileManager", "FileTools", "FileTransfer", "Filesystem", "Finance",
+    "FlowChart", "GNOME", "GTK", "GUIDesigner", "Game", "Geography", "Geology", "Geoscience", "Graphics", "HamRadio",
+    "HardwareSettings", "History", "Humanities", "IDE", "IRCClient", "ImageProcessing", "InstantMessaging", "Java",
+    "KDE", "KidsGame", "Languages", "Literature", "LogicGame", "Maps", "Math", "MedicalSoftware", "Midi", "Mixer",
+    "Monitor", "Motif", "Music", "Network", "News", "NumericalAnalysis", "OCR", "Office", "P2P", "PDA",
+    "PackageManager", "ParallelComputing", "Photography", "Physics", "Player", "Presentation", "Printing", "Profiling",
+    "ProjectManagement", "Publishing", "Qt", "RasterGraphics", "Recorder", "RemoteAccess", "RevisionControl",
+    "Robotics", "RolePlaying", "Scanning", "Science", "Screensaver", "Security", "Sequencer", "Settings", "Shell",
+    "Shooter", "Simulation", "Spirituality", "Sports", "SportsGame", "Spreadsheet", "StrategyGame", "System", "TV",
+    "Telephony", "TelephonyTools", "TerminalEmulator", "TextEditor", "TextTools", "Translation", "TrayIcon", "Tuner",
+    "Utility", "VectorGraphics", "Video", "VideoConference", "Viewer", "WebBrowser", "WebDevelopment", "WordProcessor",
+    "XFCE"
+};
+
+static const size_t kRegisteredCount = sizeof(kRegisteredCategories) / sizeof(kRegisteredCategories[0]);
+static const size_t kWordBits = 64;
+
+bool CategorySet::empty() const
+{
+    for (auto word : words_) {
+        if (word != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CategorySet::contains(size_t atom) const
+{
+    auto word = atom / kWordBits;
+    return word < words_.size() && (words_[word] & (uint64_t(1) << (atom % kWordBits)));
+}
+
+void CategorySet::insert(size_t atom)
+{
+    auto word = atom / kWordBits;
+    if (word >= words_.size()) {
+        words_.resize(word + 1, 0);
+    }
+    words_[word] |= uint64_t(1) << (atom % kWordBits);
+}
+
+bool CategorySet::intersects(const CategorySet &other) const
+{
+    auto count = std::min(words_.size(), other.words_.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (words_[i] & other.words_[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CategorySet::eachAtom(const std::function<void(size_t)> &visitor) const
+{
+    for (size_t i = 0; i < words_.size(); ++i) {
+        for (auto word = words_[i]; word != 0; word &= word - 1) {
+            visitor(i * kWordBits + __builtin_ctzll(word));
+        }
+    }
+}
+
+size_t CategoryAtoms::registeredCount()
+{
+    return kRegisteredCount;
+}
+
+size_t CategoryAtoms::atom(const std::string &name)
+{
+    size_t found;
+    if (find(name, &found)) {
+        return found;
+    }
+
+    auto next = kRegisteredCount + custom_names_.size();
+    auto position = std::lower_bound(custom_atoms_.begin(), custom_atoms_.end(), name, [](const std::pair<std::string, size_t> &a, const std::string &b) {
+        return a.first < b;
+    });
+    custom_atoms_.insert(position, std::make_pair(name, next));
+    custom_names_.push_back(name);
+    return next;
+}
+
+bool CategoryAtoms::find(const std::string &name, size_t *atom) const
+{
+    return find(LineView(name.data(), name.data() + name.size()), atom);
+}
+
+bool CategoryAtoms::find(const LineView &name, size_t *atom) const
+{
+    auto end = kRegisteredCategories + kRegisteredCount;
+    // A registered name that matches all of the given characters is either the same or longer, so it never sorts before
+    auto it = std::lower_bound(kRegisteredCategories, end, name, [](const char *a, const LineView &b) {
+        return strncmp(a, b.begin(), b.size()) < 0;
+    });
+    if (it != end && strncmp(*it, name.begin(), name.size()) == 0 && (*it)[name.size()] == '\0') {
+        *atom = it - kRegisteredCategories;
+        return true;
+    }
+
+    auto custom = std::lower_bound(custom_atoms_.begin(), custom_atoms_.end(), name, [](const std::pair<std::string, size_t> &a, const LineView &b) {
+        auto result = memcmp(a.first.data(), b.begin(), std::min(a.first.size(), b.size()));
+        return result != 0 ? result < 0 : a.first.size() < b.size();
+    });
+    if (custom != custom_atoms_.end() && name.is(custom->first.data(), custom->first.size())) {
+        *atom = custom->second;
+        return true;
+    }
+    return false;
+}
+
+std::string CategoryAtoms::name(size_t atom) const
+{
+    if (atom < kRegisteredCount) {
+        return kRegisteredCategories[atom];
+    }
+    return atom - kRegisteredCount < custom_names_.size() ? custom_names_[atom - kRegisteredCount] : "";
+}
+
+CategorySet CategoryAtoms::internAll(const std::vector<std::string> &names)
+{
+    CategorySet categories;
+    for (const auto &name : names) {
+        categories.insert(atom(name));
+    }
+    return categories;
+}
+
+} // namespace amm
@@ -19,6 +19,8 @@
 #include "command_line_options_parser.h"
 
 #include <getopt.h>
+#include <cerrno>
+#include <cstdlib>
 #include <string>
 #include <vector>
 
@@ -27,6 +29,21 @@
 
 namespace amm {
 
+static const long kMaxJobs = 1024;
+
+// Accepts only a whole number of jobs from 1 to kMaxJobs, without trailing characters
+static bool parseJobs(const char *text, int *jobs)
+{
+    char *end;
+    errno = 0;
+    auto value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < 1 || value > kMaxJobs) {
+        return false;
+    }
+    *jobs = static_cast<int>(value);
+    return true;
+}
+
 AmmOptions CommandLineOptionsParser::parse(int argc, char* const* argv)
 {
     allowMultipleEntries();
@@ -35,7 +52,7 @@ AmmOptions CommandLineOptionsParser::parse(int argc, char* const* argv)
     auto option_index = 0;
     auto help_flag = 0;
     auto version_flag = 0;
-    const char* short_options = "o:i:c:v";
+    const char* short_options = "o:i:c:j:v";
     const option long_options[] = {
         {"help",            no_argument,       &help_flag   ,  1 },
         {"version",         no_argument,       &version_flag,  1 },
@@ -44,6 +61,9 @@ AmmOptions CommandLineOptionsParser::parse(int argc, char* const* argv)
         {"output-file",     required_argument, 0,             'o'},
         {"input-directory", required_argument, 0,             'i'},
         {"category-file",   required_argument, 0,             'c'},
+        {"jobs",            required_argument, 0,             'j'},
+        {"watch",           no_argument,       0,              0 },
+        {"trace",           required_argument, 0,              0 },
         {"summary",         required_argument, 0,              0 },
         {"language",        required_argument, 0,              0 },
         {0,                 0,                 0,              0 },
@@ -74,6 +94,12 @@ AmmOptions CommandLineOptionsParser::parse(int argc, char* const* argv)
             if (long_option_name == "language") {
                 amm_options.language = optarg;
             }
+            if (long_option_name == "watch") {
+                amm_options.is_watch = true;
+            }
+            if (long_option_name == "trace") {
+                amm_options.trace_file_name = optarg;
+            }
         } else if (chosen_option == 'o') {
             amm_options.output_file_name = optarg;
         } else if (chosen_option == 'i') {
@@ -81,6 +107,10 @@ AmmOptions CommandLineOptionsParser::parse(int argc, char* const* argv)
             amm_options.input_directory_names = StringX(optarg).split(":");
         } else if (chosen_option == 'c') {
             amm_options.category_file_name = optarg;
+        } else if (chosen_option == 'j') {
+            if (!parseJobs(optarg, &amm_options.jobs)) {
+                amm_options.is_parsed = false;
+            }
         } else if (chosen_option == 'v') {
             amm_options.summary_type = "long";
         } else {
@@ -18,7 +18,12 @@
 
 #include "desktop_entry_file_search.h"
 
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -26,9 +31,13 @@
 #include "vectorx.h"
 #include "directoryx.h"
 #include "system_environment.h"
+#include "trace.h"
 
 namespace amm {
 
+static const char kExtension[] = ".desktop";
+static const size_t kExtensionLength = sizeof(kExtension) - 1;
+
 static std::vector<std::string> defaultDirectories()
 {
     std::vector<std::string> existing_directories;
@@ -55,32 +64,64 @@ void DesktopEntryFileSearch::resolve()
     auto unique_names = VectorX(terminated_names).unique();
 
     for (const auto &name : unique_names) {
+        Trace::Span span(trace_, "search", "directory");
+        span.annotate("directory", name);
         populate(name);
     }
 }
 
 void DesktopEntryFileSearch::populate(const std::string &directory_name)
 {
-    auto directory = DirectoryX {directory_name};
-
-    if (!directory.isValid()) {
+    int descriptor = open(directory_name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (descriptor < 0) {
         bad_paths_.push_back(directory_name);
         return;
     }
 
-    auto entries = directory.allEntries();
+    auto path = StringX(directory_name).terminateWith("/");
+    path.reserve(256);
+    populate(descriptor, &path);
+}
 
-    for (const auto &entry : entries) {
-        auto entry_name = entry.name();
-        auto full_path = StringX(directory_name).terminateWith("/") + entry_name;
+// Sub-directories are opened relative to their parent's descriptor, and the path is extended in place
+// Only entries whose type readdir() doesn't know, and symbolic links, need an fstatat()
+// Takes ownership of the descriptor
+void DesktopEntryFileSearch::populate(int descriptor, std::string *path)
+{
+    DIR *directory = fdopendir(descriptor);
+    if (directory == nullptr) {
+        close(descriptor);
+        return;
+    }
+
+    auto path_length = path->size();
+    dirent *entry;
+    while ((entry = readdir(directory)) != nullptr) {
+        auto name = entry->d_name;
+        if (std::strcmp(name, ".") == 0 || std::strcmp(name, "..") == 0) {
+            continue;
+        }
 
-        if (StringX(entry_name).endsWith(".desktop")) {
-            desktop_file_names_.push_back(full_path);
+        auto name_length = std::strlen(name);
+        if (name_length >= kExtensionLength && std::strcmp(name + name_length - kExtensionLength, kExtension) == 0) {
+            desktop_file_names_.push_back(*path + name);
         }
 
-        if (entry.isDirectory() && entry_name != ".." && entry_name != ".") {
-            populate(full_path);
+        auto is_directory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+            struct stat st;
+            is_directory = fstatat(descriptor, name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+        }
+        if (is_directory) {
+            int subdirectory_descriptor = openat(descriptor, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (subdirectory_descriptor >= 0) {
+                path->append(name, name_length);
+                path->push_back('/');
+                populate(subdirectory_descriptor, path);
+                path->resize(path_length);
+            }
         }
     }
+    closedir(directory);
 }
 } // namespace amm
@@ -0,0 +1,171 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "desktop_entry_file_watch.h"
+
+#include <sys/inotify.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "stringx.h"
+#include "directoryx.h"
+
+namespace amm {
+
+static const uint32_t kWatchedEvents = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+DesktopEntryFileWatch::DesktopEntryFileWatch() : descriptor_(inotify_init1(IN_CLOEXEC | IN_NONBLOCK)), has_wait_signal_mask_(false)
+{
+    sigemptyset(&wait_signal_mask_);
+}
+
+DesktopEntryFileWatch::~DesktopEntryFileWatch()
+{
+    if (descriptor_ >= 0) {
+        close(descriptor_);
+    }
+}
+
+void DesktopEntryFileWatch::registerDirectories(const std::vector<std::string> &directory_names)
+{
+    for (const auto &directory_name : directory_names) {
+        watch(StringX(directory_name).terminateWith("/"));
+    }
+}
+
+std::vector<std::string> DesktopEntryFileWatch::watchedDirectoryNames() const
+{
+    std::vector<std::string> names;
+    for (const auto &watched : directory_names_) {
+        names.push_back(watched.second);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+void DesktopEntryFileWatch::registerWaitSignalMask(const sigset_t &signal_mask)
+{
+    wait_signal_mask_ = signal_mask;
+    has_wait_signal_mask_ = true;
+}
+
+void DesktopEntryFileWatch::watch(const std::string &directory_name)
+{
+    if (!isValid()) {
+        return;
+    }
+
+    auto watch_descriptor = inotify_add_watch(descriptor_, directory_name.c_str(), kWatchedEvents);
+    if (watch_descriptor < 0) {
+        return;
+    }
+    directory_names_[watch_descriptor] = directory_name;
+
+    auto entries = DirectoryX(directory_name).allEntries();
+    for (const auto &entry : entries) {
+        auto entry_name = entry.name();
+        if (entry.isDirectory() && entry_name != ".." && entry_name != ".") {
+            watch(directory_name + entry_name + "/");
+        }
+    }
+}
+
+bool DesktopEntryFileWatch::wait(std::vector<std::string> *file_names, bool *is_rescan_needed, int settle_milliseconds)
+{
+    file_names->clear();
+    *is_rescan_needed = false;
+    if (!isValid()) {
+        return false;
+    }
+
+    pollfd poll_descriptor = { descriptor_, POLLIN, 0 };
+    timespec settle_time = { settle_milliseconds / 1000, (settle_milliseconds % 1000) * 1000000L };
+    auto is_settling = false;
+    while (true) {
+        auto ready = ppoll(&poll_descriptor, 1, is_settling ? &settle_time : nullptr, has_wait_signal_mask_ ? &wait_signal_mask_ : nullptr);
+        if (ready < 0) {
+            return false;
+        }
+        if (ready == 0) {
+            if (!file_names->empty() || *is_rescan_needed) {
+                break;
+            }
+            is_settling = false;
+            continue;
+        }
+        if (!readEvents(file_names, is_rescan_needed)) {
+            return false;
+        }
+        is_settling = true;
+    }
+
+    std::sort(file_names->begin(), file_names->end());
+    file_names->erase(std::unique(file_names->begin(), file_names->end()), file_names->end());
+    return true;
+}
+
+bool DesktopEntryFileWatch::readEvents(std::vector<std::string> *file_names, bool *is_rescan_needed)
+{
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        auto length = read(descriptor_, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) {
+            return false;
+        }
+        if (length <= 0) {
+            return true;
+        }
+
+        for (auto position = buffer; position < buffer + length; ) {
+            auto event = reinterpret_cast<const inotify_event*>(position);
+            position += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_IGNORED) {
+                directory_names_.erase(event->wd);
+                continue;
+            }
+            if (event->mask & IN_Q_OVERFLOW) {
+                *is_rescan_needed = true;
+                continue;
+            }
+
+            auto directory = directory_names_.find(event->wd);
+            if (directory == directory_names_.end() || event->len == 0) {
+                continue;
+            }
+            auto name = std::string { event->name };
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watch(directory->second + name + "/");
+                }
+                *is_rescan_needed = true;
+            } else if (StringX(name).endsWith(".desktop")) {
+                file_names->push_back(directory->second + name);
+            }
+        }
+    }
+}
+
+} // namespace amm
@@ -0,0 +1,189 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "desktop_entry_manifest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "filex.h"
+#include "line_view.h"
+#include "stringx.h"
+#include "xdg/desktop_entry.h"
+
+namespace amm {
+
+static const std::string kHeader = "amm-manifest-1 ";
+// Bumped whenever the same desktop file can be parsed into a different entry, so that recorded entries are discarded
+static const int kParserRevision = 3;
+static const char kDelimiter = '\t';
+static const size_t kFieldCount = 9;
+
+// Each category is terminated with a ';', so that empty categories survive a round trip
+static std::string joinCategories(const std::vector<std::string> &categories)
+{
+    std::string result;
+    for (const auto &category : categories) {
+        result += category + ";";
+    }
+    return result;
+}
+
+static std::vector<std::string> splitCategories(const std::string &value)
+{
+    std::vector<std::string> categories;
+    size_t start = 0;
+    size_t end;
+    while ((end = value.find(';', start)) != std::string::npos) {
+        categories.push_back(value.substr(start, end - start));
+        start = end + 1;
+    }
+    return categories;
+}
+
+DesktopEntryManifest::DesktopEntryManifest(const std::string &file_name, const std::string &language) :
+        file_name_(file_name), language_(language), is_dirty_(false)
+{
+    load();
+}
+
+DesktopEntryManifest::~DesktopEntryManifest()
+{
+    if (is_dirty_) {
+        save();
+    }
+}
+
+bool DesktopEntryManifest::find(const std::string &desktop_file_name, long long modification_time, long long size, xdg::DesktopEntry *entry) const
+{
+    auto it = records_.find(desktop_file_name);
+    if (it == records_.end() || it->second.modification_time != modification_time || it->second.size != size) {
+        return false;
+    }
+    *entry = it->second.entry;
+    return true;
+}
+
+void DesktopEntryManifest::add(const std::string &desktop_file_name, long long modification_time, long long size, const xdg::DesktopEntry &entry)
+{
+    auto it = records_.find(desktop_file_name);
+    if (it != records_.end() && it->second.modification_time == modification_time && it->second.size == size) {
+        return;
+    }
+    records_[desktop_file_name] = Record { modification_time, size, entry };
+    is_dirty_ = true;
+}
+
+void DesktopEntryManifest::remove(const std::string &desktop_file_name)
+{
+    if (records_.erase(desktop_file_name) > 0) {
+        is_dirty_ = true;
+    }
+}
+
+void DesktopEntryManifest::retainOnly(const std::vector<std::string> &desktop_file_names)
+{
+    std::unordered_set<std::string> retained(desktop_file_names.begin(), desktop_file_names.end());
+    for (auto it = records_.begin(); it != records_.end(); ) {
+        if (retained.find(it->first) == retained.end()) {
+            it = records_.erase(it);
+            is_dirty_ = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string DesktopEntryManifest::header() const
+{
+    return kHeader + std::to_string(kParserRevision) + ' ' + language_;
+}
+
+void DesktopEntryManifest::load()
+{
+    std::string content;
+    if (!FileX(file_name_).readAll(&content)) {
+        return;
+    }
+
+    LineScanner scanner(content);
+    LineView line;
+    if (!scanner.next(&line) || line.str() != header()) {
+        return;
+    }
+
+    while (scanner.next(&line)) {
+        std::vector<LineView> fields;
+        auto field_begin = line.begin();
+        while (fields.size() < kFieldCount) {
+            auto field_end = LineView(field_begin, line.end()).find(kDelimiter);
+            if (field_end == nullptr) {
+                fields.push_back(LineView(field_begin, line.end()));
+                break;
+            }
+            fields.push_back(LineView(field_begin, field_end));
+            field_begin = field_end + 1;
+        }
+        if (fields.size() != kFieldCount) {
+            continue;
+        }
+
+        auto entry = xdg::DesktopEntry(fields[3].unescapeField(), fields[4].unescapeField(), fields[5].unescapeField(),
+                                       splitCategories(fields[7].unescapeField()), fields[6].unescapeField(), fields[8].is("1", 1));
+        auto record = Record { std::atoll(fields[1].str().c_str()), std::atoll(fields[2].str().c_str()), entry };
+        records_[fields[0].unescapeField()] = record;
+    }
+}
+
+bool DesktopEntryManifest::save() const
+{
+    std::vector<std::string> lines;
+    lines.reserve(records_.size() + 1);
+    lines.push_back(header());
+    for (const auto &record : records_) {
+        const auto &entry = record.second.entry;
+        lines.push_back(StringX(record.first).escapeField() + kDelimiter +
+                        std::to_string(record.second.modification_time) + kDelimiter +
+                        std::to_string(record.second.size) + kDelimiter +
+                        StringX(entry.name()).escapeField() + kDelimiter +
+                        StringX(entry.icon()).escapeField() + kDelimiter +
+                        StringX(entry.executable()).escapeField() + kDelimiter +
+                        StringX(entry.comment()).escapeField() + kDelimiter +
+                        StringX(joinCategories(entry.categories())).escapeField() + kDelimiter +
+                        (entry.display() ? "1" : "0"));
+    }
+
+    auto temporary_file_name = file_name_ + ".tmp";
+    std::remove(temporary_file_name.c_str());
+    if (!FileX(temporary_file_name).writeLines(lines)) {
+        return false;
+    }
+    if (!FileX(temporary_file_name).moveTo(file_name_)) {
+        std::remove(temporary_file_name.c_str());
+        return false;
+    }
+
+    is_dirty_ = false;
+    return true;
+}
+
+} // namespace amm
@@ -19,11 +19,11 @@
 #include "directoryx.h"
 
 #include <dirent.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cerrno>
 #include <string>
 
-#include "stringx.h"
-#include "filex.h"
-
 namespace amm {
 bool DirectoryX::isValid() const
 {
@@ -36,6 +36,11 @@ bool DirectoryX::isValid() const
     }
 }
 
+bool DirectoryX::create() const
+{
+    return mkdir(path_.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
 DirectoryX::Entries::Entries(const std::string &path) : path_(path)
 {
     directory_ = opendir(path.c_str());
@@ -48,12 +53,17 @@ DirectoryX::Entries::~Entries()
     }
 }
 
+// The entry type from readdir() is trusted; only unknown types and symbolic links are looked up
 DirectoryX::Entries::SearchResult DirectoryX::Entries::nextName()
 {
     dirent *entry_;
     while((entry_ = readdir(directory_)) != nullptr) {
-        auto full_path = StringX(path_).terminateWith("/") + entry_->d_name;
-        current_result_ = SearchResult::Success(entry_->d_name, FileX(full_path).existsAsDirectory());
+        auto is_directory = entry_->d_type == DT_DIR;
+        if (entry_->d_type == DT_UNKNOWN || entry_->d_type == DT_LNK) {
+            struct stat st;
+            is_directory = fstatat(dirfd(directory_), entry_->d_name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+        }
+        current_result_ = SearchResult::Success(entry_->d_name, is_directory);
         return current_result_;
     }
     current_result_ = SearchResult::Bad();
@@ -19,6 +19,9 @@
 #include "filex.h"
 
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -39,6 +42,26 @@ bool FileX::existsAsDirectory() const
     return result == 0 && S_ISDIR(st.st_mode);
 }
 
+long FileX::modificationTime() const
+{
+    struct stat st;
+    if (stat(name_.c_str(), &st) != 0) {
+        return 0;
+    }
+    return static_cast<long>(st.st_mtime);
+}
+
+bool FileX::status(long long *modification_time, long long *size) const
+{
+    struct stat st;
+    if (stat(name_.c_str(), &st) != 0) {
+        return false;
+    }
+    *modification_time = static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    *size = static_cast<long long>(st.st_size);
+    return true;
+}
+
 bool FileX::moveTo(const std::string &new_path) const
 {
     return rename(name_.c_str(), new_path.c_str()) == 0;
@@ -60,6 +83,47 @@ bool FileX::readLines(std::vector<std::string> *lines) const
     return true;
 }
 
+bool FileX::readAll(std::string *content) const
+{
+    int descriptor = open(name_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(descriptor, &st) != 0 || S_ISDIR(st.st_mode)) {
+        close(descriptor);
+        return false;
+    }
+
+    // One byte beyond the reported size lets a single read() hit the end of file; files that
+    // don't report a size, or grow meanwhile, are read in growing chunks
+    std::string buffer(st.st_size > 0 ? static_cast<size_t>(st.st_size) + 1 : 4096, '\0');
+    size_t length = 0;
+    while (true) {
+        if (length == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        auto count = read(descriptor, &buffer[length], buffer.size() - length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            close(descriptor);
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        length += static_cast<size_t>(count);
+    }
+    close(descriptor);
+
+    buffer.resize(length);
+    content->swap(buffer);
+    return true;
+}
+
 bool FileX::writeLines(const std::vector<std::string> &lines) const
 {
     if (exists()) {
@@ -78,4 +142,27 @@ bool FileX::writeLines(const std::vector<std::string> &lines) const
     return true;
 }
 
+bool FileX::writeAll(const std::string &content) const
+{
+    int descriptor = open(name_.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    size_t length = 0;
+    while (length < content.size()) {
+        auto count = write(descriptor, content.data() + length, content.size() - length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            close(descriptor);
+            return false;
+        }
+        length += static_cast<size_t>(count);
+    }
+
+    return close(descriptor) == 0;
+}
+
 } // namespace amm
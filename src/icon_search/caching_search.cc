@@ -0,0 +1,153 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/caching_search.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace amm {
+namespace icon_search {
+
+CachingSearch::Shard& CachingSearch::shardFor(const std::string &icon_name) const
+{
+    return shards_[std::hash<std::string>()(icon_name) % kShardCount];
+}
+
+// The first asker inserts an unresolved entry and searches without holding the lock
+// Entries of an unordered_map don't move when it grows, so the entry can be filled in afterwards
+// If that search throws, the entry is abandoned and a waiting asker searches again in its place
+std::string CachingSearch::resolvedName(const std::string &icon_name) const
+{
+    auto &shard = shardFor(icon_name);
+    {
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        std::string resolved_name;
+        while (!shard.entries.insert(std::make_pair(icon_name, Entry())).second) {
+            if (waitFor(icon_name, &lock, &resolved_name)) {
+                return resolved_name;
+            }
+        }
+    }
+
+    std::string result;
+    try {
+        result = actual_searcher_->resolvedName(icon_name);
+    } catch (...) {
+        abandon({ icon_name });
+        throw;
+    }
+    store(icon_name, result);
+    return result;
+}
+
+std::vector<std::string> CachingSearch::resolveAll(const std::vector<std::string> &icon_names) const
+{
+    std::vector<std::string> claimed_names;
+    for (const auto &icon_name : icon_names) {
+        auto &shard = shardFor(icon_name);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.entries.insert(std::make_pair(icon_name, Entry())).second) {
+            claimed_names.push_back(icon_name);
+        }
+    }
+
+    if (!claimed_names.empty()) {
+        std::vector<std::string> claimed_results;
+        try {
+            claimed_results = actual_searcher_->resolveAll(claimed_names);
+        } catch (...) {
+            abandon(claimed_names);
+            throw;
+        }
+        for (size_t i = 0; i < claimed_names.size(); ++i) {
+            store(claimed_names[i], claimed_results[i]);
+        }
+    }
+
+    std::vector<std::string> resolved_names;
+    resolved_names.reserve(icon_names.size());
+    for (const auto &icon_name : icon_names) {
+        std::string resolved_name;
+        {
+            std::unique_lock<std::mutex> lock(shardFor(icon_name).mutex);
+            if (waitFor(icon_name, &lock, &resolved_name)) {
+                resolved_names.push_back(resolved_name);
+                continue;
+            }
+        }
+        resolved_names.push_back(resolvedName(icon_name));
+    }
+    return resolved_names;
+}
+
+void CachingSearch::store(const std::string &icon_name, const std::string &resolved_name) const
+{
+    auto &shard = shardFor(icon_name);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto &entry = shard.entries[icon_name];
+        entry.resolved_name = resolved_name;
+        entry.is_resolved = true;
+    }
+    shard.resolved.notify_all();
+}
+
+// Waiters are woken so that they find the entries gone and search for themselves
+void CachingSearch::abandon(const std::vector<std::string> &icon_names) const
+{
+    for (const auto &icon_name : icon_names) {
+        auto &shard = shardFor(icon_name);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.entries.erase(icon_name);
+        }
+        shard.resolved.notify_all();
+    }
+}
+
+// The entry is looked up again on every wake-up, since an abandoned entry is erased
+// Fails when the entry is missing or has been abandoned
+bool CachingSearch::waitFor(const std::string &icon_name, std::unique_lock<std::mutex> *lock, std::string *resolved_name) const
+{
+    auto &shard = shardFor(icon_name);
+    auto it = shard.entries.end();
+    shard.resolved.wait(*lock, [&shard, &icon_name, &it] {
+        it = shard.entries.find(icon_name);
+        return it == shard.entries.end() || it->second.is_resolved;
+    });
+    if (it == shard.entries.end()) {
+        return false;
+    }
+    *resolved_name = it->second.resolved_name;
+    return true;
+}
+
+bool CachingSearch::isCached(const std::string &icon_name) const
+{
+    auto &shard = shardFor(icon_name);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(icon_name);
+    return it != shard.entries.end() && it->second.is_resolved;
+}
+
+} // namespace icon_search
+} // namespace amm
@@ -0,0 +1,104 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/directory_index.h"
+
+#include <dirent.h>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+#include "stringx.h"
+
+namespace amm {
+namespace icon_search {
+
+std::vector<std::string> DirectoryIndex::fileNames(const std::string &directory_name, const std::string &icon_name) const
+{
+    std::vector<std::string> file_names;
+    eachFileName(directory_name, { icon_name }, [&file_names](size_t, const std::string &file_name) {
+        file_names.push_back(file_name);
+    });
+    return file_names;
+}
+
+void DirectoryIndex::eachFileName(const std::string &directory_name, const std::vector<std::string> &icon_names,
+                                  const std::function<void(size_t, const std::string&)> &found) const
+{
+    const auto &entries = listing(directory_name);
+    if (entries.empty()) {
+        return;
+    }
+
+    for (size_t n = 0; n < icon_names.size(); ++n) {
+        const auto &icon_name = icon_names[n];
+        for (size_t i = 0; i < registered_extensions_.size(); ++i) {
+            const auto &extension = registered_extensions_[i];
+            auto has_extension = icon_name.size() >= extension.size() &&
+                icon_name.compare(icon_name.size() - extension.size(), extension.size(), extension) == 0;
+            auto it = has_extension ? entries.find(icon_name.substr(0, icon_name.size() - extension.size())) : entries.find(icon_name);
+            if (it != entries.end() && (it->second & (1U << i))) {
+                found(n, directory_name + "/" + it->first + extension);
+            }
+        }
+    }
+}
+
+bool DirectoryIndex::isIndexed(const std::string &directory_name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return listings_.find(directory_name) != listings_.end();
+}
+
+// A directory is read without holding the lock; if two threads read it at once, the first listing stored is kept
+// Listings don't move once stored, so references to them stay valid
+const DirectoryIndex::Listing& DirectoryIndex::listing(const std::string &directory_name) const
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = listings_.find(directory_name);
+        if (it != listings_.end()) {
+            return it->second;
+        }
+    }
+
+    Listing entries;
+    DIR *directory = opendir(directory_name.c_str());
+    if (directory != nullptr) {
+        dirent *entry;
+        while ((entry = readdir(directory)) != nullptr) {
+            std::string name = entry->d_name;
+            for (size_t i = 0; i < registered_extensions_.size(); ++i) {
+                const auto &extension = registered_extensions_[i];
+                if (name.size() > extension.size() && StringX(name).endsWith(extension)) {
+                    entries[name.substr(0, name.size() - extension.size())] |= (1U << i);
+                }
+            }
+        }
+        closedir(directory);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return listings_.insert(std::make_pair(directory_name, std::move(entries))).first->second;
+}
+
+} // namespace icon_search
+} // namespace amm
@@ -0,0 +1,261 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/icon_theme_cache.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "stringx.h"
+
+namespace amm {
+namespace icon_search {
+
+// The layout is described in gtk/gtkiconcachevalidator.c; all numbers are big-endian
+static const uint16_t kMajorVersion = 1;
+static const uint32_t kHashOffsetLocation = 4;
+static const uint32_t kDirectoryListOffsetLocation = 8;
+static const uint32_t kNone = 0xFFFFFFFF;
+static const uint16_t kHasSuffixXpm = 1;
+static const uint16_t kHasSuffixSvg = 2;
+static const uint16_t kHasSuffixPng = 4;
+
+static uint16_t suffixFlag(const std::string &extension)
+{
+    if (extension == ".png") {
+        return kHasSuffixPng;
+    }
+    if (extension == ".svg") {
+        return kHasSuffixSvg;
+    }
+    if (extension == ".xpm") {
+        return kHasSuffixXpm;
+    }
+    return 0;
+}
+
+// Same as GTK's icon_name_hash(), which hashes signed characters
+static uint32_t iconNameHash(const std::string &icon_name)
+{
+    if (icon_name.empty()) {
+        return 0;
+    }
+    auto characters = reinterpret_cast<const signed char*>(icon_name.c_str());
+    uint32_t hash = static_cast<uint32_t>(characters[0]);
+    for (auto character = characters + 1; *character != '\0'; ++character) {
+        hash = (hash << 5) - hash + static_cast<uint32_t>(*character);
+    }
+    return hash;
+}
+
+IconThemeCache::IconThemeCache(const std::string &theme_directory_name, const std::vector<std::string> &registered_extensions) :
+        registered_extensions_(registered_extensions), data_(nullptr), size_(0)
+{
+    struct stat directory_status;
+    struct stat cache_status;
+    auto file_name = StringX(theme_directory_name).terminateWith("/") + "icon-theme.cache";
+    if (stat(theme_directory_name.c_str(), &directory_status) != 0 || stat(file_name.c_str(), &cache_status) != 0) {
+        return;
+    }
+    if (cache_status.st_mtime < directory_status.st_mtime) {
+        return;
+    }
+
+    if (!map(file_name) || !indexSubdirectories()) {
+        unmap();
+    }
+}
+
+IconThemeCache::~IconThemeCache()
+{
+    unmap();
+}
+
+bool IconThemeCache::hasSubdirectory(const std::string &subdirectory_name) const
+{
+    return subdirectory_indices_.find(subdirectory_name) != subdirectory_indices_.end();
+}
+
+std::vector<std::string> IconThemeCache::fileNames(const std::string &directory_name, const std::string &subdirectory_name, const std::string &icon_name) const
+{
+    std::vector<std::string> file_names;
+    eachFileName(directory_name, subdirectory_name, { icon_name }, [&file_names](size_t, const std::string &file_name) {
+        file_names.push_back(file_name);
+    });
+    return file_names;
+}
+
+void IconThemeCache::eachFileName(const std::string &directory_name, const std::string &subdirectory_name, const std::vector<std::string> &icon_names,
+                                  const std::function<void(size_t, const std::string&)> &found) const
+{
+    auto subdirectory = subdirectory_indices_.find(subdirectory_name);
+    if (!isValid() || subdirectory == subdirectory_indices_.end()) {
+        return;
+    }
+
+    for (size_t n = 0; n < icon_names.size(); ++n) {
+        const auto &icon_name = icon_names[n];
+        for (const auto &extension : registered_extensions_) {
+            auto base_name = StringX(icon_name).endsWith(extension) ? icon_name.substr(0, icon_name.size() - extension.size()) : icon_name;
+            auto image_list_offset = imageListOffset(base_name);
+            uint32_t image_count;
+            if (image_list_offset == kNone || !read32(image_list_offset, &image_count)) {
+                continue;
+            }
+
+            for (uint32_t i = 0; i < image_count; ++i) {
+                uint16_t directory_index;
+                uint16_t flags;
+                auto image_offset = image_list_offset + 4 + i * 8;
+                if (!read16(image_offset, &directory_index) || !read16(image_offset + 2, &flags)) {
+                    break;
+                }
+                if (directory_index == subdirectory->second && (flags & suffixFlag(extension))) {
+                    found(n, directory_name + "/" + base_name + extension);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool IconThemeCache::map(const std::string &file_name)
+{
+    int descriptor = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(descriptor, &st) != 0 || st.st_size < 12) {
+        close(descriptor);
+        return false;
+    }
+
+    auto mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    data_ = static_cast<const unsigned char*>(mapping);
+    size_ = static_cast<size_t>(st.st_size);
+    uint16_t major_version;
+    return read16(0, &major_version) && major_version == kMajorVersion;
+}
+
+bool IconThemeCache::indexSubdirectories()
+{
+    uint32_t directory_list_offset;
+    uint32_t directory_count;
+    if (!read32(kDirectoryListOffsetLocation, &directory_list_offset) || !read32(directory_list_offset, &directory_count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < directory_count && i <= UINT16_MAX; ++i) {
+        uint32_t name_offset;
+        if (!read32(directory_list_offset + 4 + i * 4, &name_offset)) {
+            return false;
+        }
+        auto name = stringAt(name_offset);
+        if (name == nullptr) {
+            return false;
+        }
+        subdirectory_indices_[name] = static_cast<uint16_t>(i);
+    }
+    return true;
+}
+
+bool IconThemeCache::read16(uint32_t offset, uint16_t *value) const
+{
+    if (static_cast<size_t>(offset) + 2 > size_) {
+        return false;
+    }
+    *value = static_cast<uint16_t>((data_[offset] << 8) | data_[offset + 1]);
+    return true;
+}
+
+bool IconThemeCache::read32(uint32_t offset, uint32_t *value) const
+{
+    if (static_cast<size_t>(offset) + 4 > size_) {
+        return false;
+    }
+    *value = (static_cast<uint32_t>(data_[offset]) << 24) | (static_cast<uint32_t>(data_[offset + 1]) << 16) |
+             (static_cast<uint32_t>(data_[offset + 2]) << 8) | static_cast<uint32_t>(data_[offset + 3]);
+    return true;
+}
+
+// Strings must be terminated within the file, so a damaged cache can't be read past its end
+const char *IconThemeCache::stringAt(uint32_t offset) const
+{
+    if (offset >= size_ || std::memchr(data_ + offset, '\0', size_ - offset) == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<const char*>(data_ + offset);
+}
+
+uint32_t IconThemeCache::imageListOffset(const std::string &icon_name) const
+{
+    uint32_t hash_offset;
+    uint32_t bucket_count;
+    if (!read32(kHashOffsetLocation, &hash_offset) || !read32(hash_offset, &bucket_count) || bucket_count == 0) {
+        return kNone;
+    }
+
+    uint32_t icon_offset;
+    if (!read32(hash_offset + 4 + (iconNameHash(icon_name) % bucket_count) * 4, &icon_offset)) {
+        return kNone;
+    }
+
+    // Chains are bounded by the file size, so a cycle in a damaged cache ends the search
+    for (size_t steps = 0; icon_offset != kNone && steps < size_ / 12; ++steps) {
+        uint32_t chain_offset;
+        uint32_t name_offset;
+        uint32_t image_list_offset;
+        if (!read32(icon_offset, &chain_offset) || !read32(icon_offset + 4, &name_offset) || !read32(icon_offset + 8, &image_list_offset)) {
+            return kNone;
+        }
+        auto name = stringAt(name_offset);
+        if (name != nullptr && icon_name == name) {
+            return image_list_offset;
+        }
+        icon_offset = chain_offset;
+    }
+    return kNone;
+}
+
+void IconThemeCache::unmap()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<unsigned char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+    subdirectory_indices_.clear();
+}
+
+} // namespace icon_search
+} // namespace amm
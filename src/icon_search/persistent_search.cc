@@ -0,0 +1,152 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/persistent_search.h"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "filex.h"
+#include "line_view.h"
+#include "stringx.h"
+#include "icon_search/icon_search_interface.h"
+
+namespace amm {
+namespace icon_search {
+
+static const std::string kHeader = "amm-icon-cache-2 ";
+static const char kDelimiter = '\t';
+
+PersistentSearch::PersistentSearch(IconSearchInterface *actual_searcher, const std::string &file_name, const std::string &key) :
+        actual_searcher_(std::unique_ptr<icon_search::IconSearchInterface>{actual_searcher}), file_name_(file_name), key_(key), is_dirty_(false)
+{
+    load();
+}
+
+PersistentSearch::~PersistentSearch()
+{
+    if (is_dirty_) {
+        save();
+    }
+}
+
+std::string PersistentSearch::resolvedName(const std::string &icon_name) const
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(icon_name);
+        if (it != cache_.end()) {
+            return it->second;
+        }
+    }
+    auto result = actual_searcher_->resolvedName(icon_name);
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.insert(std::pair<std::string, std::string>(icon_name, result));
+    is_dirty_ = true;
+    return result;
+}
+
+// Names missing from the cache are searched together in one call to the underlying searcher
+std::vector<std::string> PersistentSearch::resolveAll(const std::vector<std::string> &icon_names) const
+{
+    std::vector<std::string> resolved_names(icon_names.size());
+    std::vector<std::string> missing_names;
+    std::vector<size_t> missing_indices;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < icon_names.size(); ++i) {
+            auto it = cache_.find(icon_names[i]);
+            if (it != cache_.end()) {
+                resolved_names[i] = it->second;
+            } else {
+                missing_names.push_back(icon_names[i]);
+                missing_indices.push_back(i);
+            }
+        }
+    }
+    if (missing_names.empty()) {
+        return resolved_names;
+    }
+
+    auto missing_results = actual_searcher_->resolveAll(missing_names);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < missing_names.size(); ++i) {
+        resolved_names[missing_indices[i]] = missing_results[i];
+        cache_.insert(std::pair<std::string, std::string>(missing_names[i], missing_results[i]));
+    }
+    is_dirty_ = true;
+    return resolved_names;
+}
+
+bool PersistentSearch::isCached(const std::string &icon_name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.find(icon_name) != cache_.end();
+}
+
+void PersistentSearch::load()
+{
+    std::string content;
+    if (!FileX(file_name_).readAll(&content)) {
+        return;
+    }
+
+    LineScanner scanner(content);
+    LineView line;
+    if (!scanner.next(&line) || line.str() != kHeader + key_) {
+        return;
+    }
+
+    while (scanner.next(&line)) {
+        auto delimiter = line.find(kDelimiter);
+        if (delimiter != nullptr) {
+            cache_[LineView(line.begin(), delimiter).unescapeField()] = LineView(delimiter + 1, line.end()).unescapeField();
+        }
+    }
+}
+
+bool PersistentSearch::save() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> lines;
+    lines.reserve(cache_.size() + 1);
+    lines.push_back(kHeader + key_);
+    for (const auto &entry : cache_) {
+        lines.push_back(StringX(entry.first).escapeField() + kDelimiter + StringX(entry.second).escapeField());
+    }
+
+    auto temporary_file_name = file_name_ + ".tmp";
+    remove(temporary_file_name.c_str());
+    if (!FileX(temporary_file_name).writeLines(lines)) {
+        return false;
+    }
+    if (!FileX(temporary_file_name).moveTo(file_name_)) {
+        remove(temporary_file_name.c_str());
+        return false;
+    }
+
+    is_dirty_ = false;
+    return true;
+}
+
+} // namespace icon_search
+} // namespace amm
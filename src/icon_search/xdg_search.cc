@@ -18,19 +18,38 @@
 
 #include "icon_search/xdg_search.h"
 
+#include <algorithm>
 #include <climits>
+#include <memory>
 #include <string>
+#include <sstream>
 #include <vector>
+#include <unordered_map>
 
 #include "stringx.h"
 #include "filex.h"
-#include "xdg/icon_subdirectory.h"
+#include "icon_search/directory_index.h"
+#include "icon_search/icon_theme_cache.h"
 #include "xdg/icon_theme.h"
 #include "qualified_icon_theme.h"
 
 namespace amm {
 namespace icon_search {
 
+// Bumped whenever the same themes can resolve a name differently, so that persisted results are discarded
+static const int kSearchRevision = 3;
+
+// Nanoseconds, so that an icon added in the same second as the run that built the key still changes it
+static long long modificationTime(const std::string &name)
+{
+    long long modification_time = 0;
+    long long size = 0;
+    if (!FileX(name).status(&modification_time, &size)) {
+        return 0;
+    }
+    return modification_time;
+}
+
 class Path
 {
 public:
@@ -41,119 +60,241 @@ private:
     std::string name_;
 };
 
+// Icon names are searched together, theme by theme: each planned directory is looked up once for all names still unresolved
+// A name is resolved by the first directory that has it, since the directories of a theme are ranked best size first
 class ComplaintSearch
 {
 public:
-    ComplaintSearch(const std::vector<xdg::IconTheme> &icon_themes, const std::vector<std::string> &theme_search_paths, const std::vector<std::string> &registered_extensions, int size)
-        : icon_themes_(icon_themes), theme_search_paths_(theme_search_paths), registered_extensions_(registered_extensions), size_(size) {}
+    ComplaintSearch(const std::vector<std::vector<XdgSearch::PlanEntry>> &search_plan, const DirectoryIndex &directory_index)
+        : search_plan_(search_plan), directory_index_(directory_index) {}
 
-    std::string nameInTheme(const std::string &icon_name) const
+    std::vector<std::string> namesInTheme(const std::vector<std::string> &icon_names) const
     {
-        auto search_locations = findSearchLocations(icon_name);
-        auto file_name = lookupBySize(search_locations);
+        std::vector<std::string> file_names(icon_names.size());
+        auto pending_names = icon_names;
+        std::vector<size_t> pending_indices;
+        for (size_t i = 0; i < icon_names.size(); ++i) {
+            pending_indices.push_back(i);
+        }
 
-        return file_name;
-    }
+        for (const auto &theme_plan : search_plan_) {
+            for (const auto &entry : theme_plan) {
+                if (pending_names.empty()) {
+                    return file_names;
+                }
 
-private:
-    std::vector<xdg::IconSubdirectory> findSearchLocations(const std::string &icon_name) const
-    {
-        std::vector<xdg::IconSubdirectory> search_locations;
-
-        for (const auto &icon_theme : icon_themes_) {
-            auto theme_subdirs = icon_theme.directories();
-
-            for (auto &subdir : theme_subdirs) {
-                for (const auto &search_path : theme_search_paths_) {
-                    for (const auto &extension : registered_extensions_) {
-                        auto path = Path(search_path);
-                        path.join(icon_theme.internalName());
-                        path.join(subdir.name());
-                        path.join(icon_name);
-                        auto file_name = StringX(path.result()).terminateWith(extension);
-                        if (FileX(file_name).exists()) {
-                            search_locations.push_back(xdg::IconSubdirectory(subdir.location(file_name)));
-                        }
+                auto is_found = false;
+                auto found = [&](size_t i, const std::string &file_name) {
+                    auto &result = file_names[pending_indices[i]];
+                    if (result == "") {
+                        result = file_name;
+                        is_found = true;
                     }
+                };
+                if (entry.cache != nullptr) {
+                    entry.cache->eachFileName(entry.directory_name, entry.subdirectory_name, pending_names, found);
+                } else {
+                    directory_index_.eachFileName(entry.directory_name, pending_names, found);
+                }
+
+                if (is_found) {
+                    removeResolved(file_names, &pending_names, &pending_indices);
                 }
             }
         }
 
-        return search_locations;
+        return file_names;
     }
 
-    std::string lookupBySize(const std::vector<xdg::IconSubdirectory> &search_locations) const
+private:
+    static void removeResolved(const std::vector<std::string> &file_names, std::vector<std::string> *pending_names, std::vector<size_t> *pending_indices)
     {
-        for (auto subdir : search_locations) {
-            if (subdir.matches(size_)) {
-                return subdir.location();
+        size_t kept = 0;
+        for (size_t i = 0; i < pending_names->size(); ++i) {
+            if (file_names[(*pending_indices)[i]] != "") {
+                continue;
             }
-        }
-
-        auto minimal_size = INT_MAX;
-        auto closest_file_name = std::string { "" };
-        for (const auto &subdir : search_locations) {
-            auto distance = subdir.distance(size_);
-            if (distance < minimal_size) {
-                closest_file_name = subdir.location();
-                minimal_size = distance;
+            if (kept != i) {
+                (*pending_names)[kept] = std::move((*pending_names)[i]);
+                (*pending_indices)[kept] = (*pending_indices)[i];
             }
+            ++kept;
         }
-
-        return closest_file_name;
+        pending_names->resize(kept);
+        pending_indices->resize(kept);
     }
 
-    std::vector<xdg::IconTheme> icon_themes_;
-    std::vector<std::string> theme_search_paths_;
-    std::vector<std::string> registered_extensions_;
-    int size_;
+    const std::vector<std::vector<XdgSearch::PlanEntry>> &search_plan_;
+    const DirectoryIndex &directory_index_;
 };
 
 class FallbackSearch
 {
 public:
-    FallbackSearch(const std::vector<std::string> &theme_search_paths, const std::vector<std::string> &registered_extensions)
-        : theme_search_paths_(theme_search_paths), registered_extensions_(registered_extensions) {}
-    std::string fallbackName(const std::string &icon_name) const
+    FallbackSearch(const std::vector<std::string> &theme_search_paths, const DirectoryIndex &directory_index)
+        : theme_search_paths_(theme_search_paths), directory_index_(directory_index) {}
+
+    // Only names without a file name yet are searched, and each keeps the first file found
+    void fallbackNames(const std::vector<std::string> &icon_names, std::vector<std::string> *file_names) const
     {
-        for (const auto &directory : theme_search_paths_) {
-            for (const auto &extension : registered_extensions_) {
-                auto path = Path(directory);
-                path.join(icon_name);
-                auto file_name = StringX(path.result()).terminateWith(extension);
-                if (FileX(file_name).exists()) {
-                    return file_name;
-                }
+        std::vector<std::string> pending_names;
+        std::vector<size_t> pending_indices;
+        for (size_t i = 0; i < icon_names.size(); ++i) {
+            if ((*file_names)[i] == "") {
+                pending_names.push_back(icon_names[i]);
+                pending_indices.push_back(i);
             }
         }
 
-        return "";
+        for (const auto &directory : theme_search_paths_) {
+            if (pending_names.empty()) {
+                break;
+            }
+            directory_index_.eachFileName(directory, pending_names, [&](size_t i, const std::string &file_name) {
+                auto &result = (*file_names)[pending_indices[i]];
+                if (result == "") {
+                    result = file_name;
+                }
+            });
+        }
     }
 private:
-    std::vector<std::string> theme_search_paths_;
-    std::vector<std::string> registered_extensions_;
+    const std::vector<std::string> &theme_search_paths_;
+    const DirectoryIndex &directory_index_;
 };
 
-XdgSearch::XdgSearch(int size, QualifiedIconTheme qualified_icon_theme) : size_(size)
+XdgSearch::XdgSearch(int size, QualifiedIconTheme qualified_icon_theme) :
+        size_(size), registered_extensions_({ ".png", ".svg", ".xpm" }), directory_index_(registered_extensions_)
 {
-    registered_extensions_ = { ".png", ".svg", ".xpm" };
     theme_search_paths_ = qualified_icon_theme.themeSearchPaths();
-    icon_themes_ = qualified_icon_theme.themeWithParent();
+    icon_themes_ = qualified_icon_theme.themeWithAncestors();
+
+    planSearch();
+}
+
+static void rankBySize(std::vector<XdgSearch::PlanEntry> *theme_plan)
+{
+    std::stable_sort(theme_plan->begin(), theme_plan->end(), [](const XdgSearch::PlanEntry &a, const XdgSearch::PlanEntry &b) {
+        if (a.is_match != b.is_match) {
+            return a.is_match;
+        }
+        return !a.is_match && a.distance < b.distance;
+    });
+}
+
+// Only theme directories and sub-directories that exist are planned; a theme is usually installed under one search path
+// Theme directories with an up to date icon-theme.cache are looked up in it instead of being read
+// Sub-directories that hold menu icons are planned for every theme before the others, which are searched only as a last resort
+// Sub-directories that match the size come first in their order in index.theme, followed by the rest by distance from the size
+// Sub-directories of an invalid type never hold a usable icon and are left out
+void XdgSearch::planSearch()
+{
+    std::vector<std::vector<PlanEntry>> other_plans;
+
+    for (const auto &icon_theme : icon_themes_) {
+        std::vector<std::string> theme_directories;
+        for (const auto &search_path : theme_search_paths_) {
+            auto theme_path = Path(search_path);
+            theme_path.join(icon_theme.internalName());
+            auto theme_directory = theme_path.result();
+            if (!FileX(theme_directory).existsAsDirectory()) {
+                continue;
+            }
+
+            theme_directories.push_back(theme_directory);
+            std::unique_ptr<IconThemeCache> cache { new IconThemeCache(theme_directory, registered_extensions_) };
+            if (cache->isValid()) {
+                theme_caches_[theme_directory] = std::move(cache);
+            }
+        }
+
+        std::vector<PlanEntry> menu_plan;
+        std::vector<PlanEntry> other_plan;
+        for (const auto &subdir : icon_theme.directories()) {
+            auto is_match = subdir.matches(size_);
+            auto distance = subdir.distance(size_);
+            if (!is_match && distance == INT_MAX) {
+                continue;
+            }
+
+            for (const auto &theme_directory : theme_directories) {
+                auto path = Path(theme_directory);
+                path.join(subdir.name());
+                auto cache = theme_caches_.find(theme_directory);
+                auto is_present = cache != theme_caches_.end() ? cache->second->hasSubdirectory(subdir.name()) : FileX(path.result()).existsAsDirectory();
+                if (!is_present) {
+                    continue;
+                }
+
+                PlanEntry entry;
+                entry.directory_name = path.result();
+                entry.subdirectory_name = subdir.name();
+                entry.cache = cache != theme_caches_.end() ? cache->second.get() : nullptr;
+                entry.is_match = is_match;
+                entry.distance = distance;
+                (subdir.holdsMenuIcons() ? menu_plan : other_plan).push_back(entry);
+            }
+        }
+
+        rankBySize(&menu_plan);
+        rankBySize(&other_plan);
+        search_plan_.push_back(menu_plan);
+        other_plans.push_back(other_plan);
+    }
+
+    search_plan_.insert(search_plan_.end(), other_plans.begin(), other_plans.end());
 }
 
 std::string XdgSearch::resolvedName(const std::string &icon_name) const
 {
-    auto file_name = ComplaintSearch(icon_themes_, theme_search_paths_, registered_extensions_, size_).nameInTheme(icon_name);
-    if (file_name != "") {
-        return file_name;
+    return resolveAll({ icon_name })[0];
+}
+
+// Names found neither in the theme nor directly under a search path are left as they are
+std::vector<std::string> XdgSearch::resolveAll(const std::vector<std::string> &icon_names) const
+{
+    auto file_names = ComplaintSearch(search_plan_, directory_index_).namesInTheme(icon_names);
+    FallbackSearch(theme_search_paths_, directory_index_).fallbackNames(icon_names, &file_names);
+
+    for (size_t i = 0; i < icon_names.size(); ++i) {
+        if (file_names[i] == "") {
+            file_names[i] = icon_names[i];
+        }
     }
 
-    file_name = FallbackSearch(theme_search_paths_, registered_extensions_).fallbackName(icon_name);
-    if (file_name != "") {
-        return file_name;
+    return file_names;
+}
+
+// Changes when a search path, a theme directory, its index.theme, its icon-theme.cache or any of its sub-directories is modified
+std::string XdgSearch::cacheKey() const
+{
+    std::stringstream stream;
+    stream << kSearchRevision << ';' << size_;
+
+    for (const auto &search_path : theme_search_paths_) {
+        stream << ';' << search_path << ':' << modificationTime(search_path);
+    }
+
+    for (const auto &icon_theme : icon_themes_) {
+        for (const auto &search_path : theme_search_paths_) {
+            auto theme_path = Path(search_path);
+            theme_path.join(icon_theme.internalName());
+            auto theme_directory = theme_path.result();
+            auto theme_modification_time = modificationTime(theme_directory);
+            if (theme_modification_time == 0) {
+                continue;
+            }
+
+            stream << ';' << theme_directory << ':' << theme_modification_time
+                   << ':' << modificationTime(theme_directory + "/index.theme")
+                   << ':' << modificationTime(theme_directory + "/icon-theme.cache");
+            for (const auto &subdir : icon_theme.directories()) {
+                stream << ':' << modificationTime(theme_directory + "/" + subdir.name());
+            }
+        }
     }
 
-    return icon_name;
+    return StringX(stream.str()).digest();
 }
 
 } // namespace icon_search
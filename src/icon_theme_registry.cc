@@ -0,0 +1,106 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_theme_registry.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "stringx.h"
+#include "filex.h"
+#include "directoryx.h"
+#include "xdg/icon_theme.h"
+
+namespace amm {
+
+IconThemeRegistry::IconThemeRegistry(const std::vector<std::string> &theme_search_paths)
+{
+    for (const auto &path : theme_search_paths) {
+        DirectoryX directory(path);
+        if (!directory.isValid()) {
+            continue;
+        }
+
+        auto entries = directory.allEntries();
+        for (const auto &entry : entries) {
+            auto name = entry.name();
+            if (!entry.isDirectory() || name == "." || name == "..") {
+                continue;
+            }
+
+            auto full_path = StringX(path).terminateWith("/") + StringX(name).terminateWith("/") + "index.theme";
+            std::string content;
+            if (FileX(full_path).readAll(&content)) {
+                auto position = themes_.size();
+                themes_.push_back(xdg::IconTheme(content).internalNameIs(name));
+                index_.insert(std::make_pair(themes_.back().name(), position));
+                index_.insert(std::make_pair(name, position));
+            }
+        }
+    }
+}
+
+std::vector<xdg::IconTheme> IconThemeRegistry::themeWithAncestors(const std::string &theme_name) const
+{
+    auto it = lineages_.find(theme_name);
+    if (it == lineages_.end()) {
+        std::vector<bool> visited(themes_.size(), false);
+        std::unordered_set<std::string> missing;
+        std::vector<size_t> lineage;
+        collect(theme_name, &visited, &missing, &lineage);
+        collect("hicolor", &visited, &missing, &lineage);
+        it = lineages_.insert(std::make_pair(theme_name, std::move(lineage))).first;
+    }
+
+    std::vector<xdg::IconTheme> icon_themes;
+    for (auto position : it->second) {
+        icon_themes.push_back(themes_[position]);
+    }
+    return icon_themes;
+}
+
+// A theme that isn't installed is treated like an empty index.theme, which inherits from hicolor
+void IconThemeRegistry::collect(const std::string &theme_name, std::vector<bool> *visited, std::unordered_set<std::string> *missing,
+                                std::vector<size_t> *lineage) const
+{
+    auto it = index_.find(theme_name);
+    if (it == index_.end()) {
+        if (missing->insert(theme_name).second) {
+            for (const auto &parent : xdg::IconTheme(std::vector<std::string>()).parents()) {
+                collect(parent, visited, missing, lineage);
+            }
+        }
+        return;
+    }
+
+    auto position = it->second;
+    if ((*visited)[position]) {
+        return;
+    }
+    (*visited)[position] = true;
+    lineage->push_back(position);
+
+    for (const auto &parent : themes_[position].parents()) {
+        collect(parent, visited, missing, lineage);
+    }
+}
+
+} // namespace amm
@@ -0,0 +1,92 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "line_view.h"
+
+#include <cstring>
+#include <string>
+
+namespace amm {
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool LineView::is(const char *text, size_t length) const
+{
+    return size() == length && std::memcmp(begin_, text, length) == 0;
+}
+
+bool LineView::startsWith(const char *text, size_t length) const
+{
+    return size() >= length && std::memcmp(begin_, text, length) == 0;
+}
+
+const char *LineView::find(char c) const
+{
+    if (empty()) {
+        return nullptr;
+    }
+    return static_cast<const char*>(std::memchr(begin_, c, size()));
+}
+
+LineView LineView::trim() const
+{
+    auto begin = begin_;
+    auto end = end_;
+    while (begin < end && isSpace(*begin)) {
+        ++begin;
+    }
+    while (end > begin && isSpace(*(end - 1))) {
+        --end;
+    }
+    return LineView(begin, end);
+}
+
+std::string LineView::unescapeField() const
+{
+    std::string result;
+    result.reserve(size());
+    for (auto c = begin_; c < end_; ++c) {
+        if (*c == '\\' && c + 1 < end_) {
+            ++c;
+            result += (*c == 't') ? '\t' : (*c == 'n') ? '\n' : *c;
+        } else {
+            result += *c;
+        }
+    }
+    return result;
+}
+
+bool LineScanner::next(LineView *line)
+{
+    if (next_ == nullptr || next_ >= end_) {
+        return false;
+    }
+
+    auto line_end = static_cast<const char*>(std::memchr(next_, '\n', end_ - next_));
+    if (line_end == nullptr) {
+        line_end = end_;
+    }
+    *line = LineView(next_, line_end);
+    next_ = line_end + 1;
+    return true;
+}
+
+} // namespace amm
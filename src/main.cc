@@ -16,10 +16,13 @@
   along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <clocale>
+
 #include "amm.h"
 
 int main(int argc, char *argv[])
 {
+    setlocale(LC_COLLATE, "");
     amm::Amm amm;
     amm.validateEnvironment();
     amm.loadCommandLineOption(argc, argv);
@@ -29,4 +32,6 @@ int main(int argc, char *argv[])
     amm.populate();
     amm.writeOutputFile();
     amm.printSummary();
+    amm.writeTrace();
+    amm.watch();
 }
@@ -18,12 +18,18 @@
 
 #include "menu.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <algorithm>
 
 #include "stringx.h"
 #include "filex.h"
+#include "line_view.h"
+#include "parallel.h"
 #include "icon_search/icon_search_interface.h"
 #include "icon_search/mirror_search.h"
 #include "xdg/desktop_entry.h"
@@ -36,7 +42,14 @@
 
 namespace amm {
 
-Menu::Menu() : icon_searcher_(std::unique_ptr<icon_search::IconSearchInterface>{new icon_search::MirrorSearch}), unclassified_subcategory_(Subcategory::Others())
+Menu::Menu() :
+        jobs_(1),
+        icon_searcher_(std::unique_ptr<icon_search::IconSearchInterface>{new icon_search::MirrorSearch}),
+        trace_(nullptr),
+        manifest_hits_(0),
+        manifest_misses_(0),
+        unclassified_subcategory_(Subcategory::Others()),
+        has_unclassified_subcategory_(false)
 {
     createDefaultCategories();
 }
@@ -61,11 +74,13 @@ void Menu::createDefaultCategories()
         Subcategory::Science(),
         Subcategory::System(),
     };
+    indexSubcategories();
 }
 
 void Menu::loadCustomCategories(const std::vector<std::string> &lines)
 {
     subcategories_.clear();
+    has_unclassified_subcategory_ = false;
 
     for (const auto &line : lines) {
         if (line[0] != '#') {
@@ -83,27 +98,158 @@ void Menu::loadCustomCategories(const std::vector<std::string> &lines)
             }
         }
     }
+    indexSubcategories();
 }
 
+// Each subcategory's classification names are interned as a set of atoms, which is then inverted
+// The index maps each atom to the positions of the subcategories that accept it, in menu order
+void Menu::indexSubcategories()
+{
+    subcategories_by_atom_.clear();
+    for (size_t i = 0; i < subcategories_.size(); ++i) {
+        auto classification = category_atoms_.internAll(subcategories_[i].classificationNames());
+        classification.eachAtom([this, i](size_t atom) {
+            if (atom >= subcategories_by_atom_.size()) {
+                subcategories_by_atom_.resize(atom + 1);
+            }
+            subcategories_by_atom_[atom].push_back(i);
+        });
+    }
+}
+
+// Desktop files are read and parsed on worker threads, but are added in the given order
+// This keeps the menu and its summary identical to a single-threaded run
+// Desktop files unchanged since the manifest was written are taken from it without being read
 void Menu::populate(const std::vector<std::string> &entry_names)
 {
-    for (const auto &name : entry_names) {
-        addDesktopEntry(name);
+    auto count = entry_names.size();
+    desktop_file_names_ = entry_names;
+    desktop_entries_.assign(count, xdg::DesktopEntry());
+    are_read_.assign(count, false);
+    std::vector<long long> modification_times(count, 0);
+    std::vector<long long> sizes(count, 0);
+    std::vector<char> are_in_manifest(count, false);
+
+    parallel::forEach(count, jobs_, [&](size_t i) {
+        const auto &entry_name = desktop_file_names_[i];
+        if (manifest_ && FileX(entry_name).status(&modification_times[i], &sizes[i]) &&
+                manifest_->find(entry_name, modification_times[i], sizes[i], &desktop_entries_[i])) {
+            are_in_manifest[i] = true;
+            are_read_[i] = true;
+            return;
+        }
+        are_read_[i] = readDesktopEntry(entry_name, &desktop_entries_[i]);
+    });
+
+    manifest_hits_ = 0;
+    manifest_misses_ = 0;
+    if (manifest_) {
+        manifest_->retainOnly(desktop_file_names_);
+        for (size_t i = 0; i < count; ++i) {
+            if (are_in_manifest[i]) {
+                ++manifest_hits_;
+            } else {
+                ++manifest_misses_;
+                recordInManifest(desktop_file_names_[i], are_read_[i], modification_times[i], sizes[i], desktop_entries_[i]);
+            }
+        }
+    }
+
+    classifyDesktopEntries();
+}
+
+// Only the given desktop files are read again; the rest are classified from their earlier reads
+// Files that no longer exist are dropped, and new ones are added after the known ones
+void Menu::refresh(const std::vector<std::string> &entry_names)
+{
+    for (const auto &entry_name : entry_names) {
+        auto location = std::find(desktop_file_names_.begin(), desktop_file_names_.end(), entry_name) - desktop_file_names_.begin();
+        auto is_known = static_cast<size_t>(location) < desktop_file_names_.size();
+        xdg::DesktopEntry entry;
+        long long modification_time = 0;
+        long long size = 0;
+        FileX(entry_name).status(&modification_time, &size);
+        auto is_read = readDesktopEntry(entry_name, &entry);
+        if (manifest_) {
+            recordInManifest(entry_name, is_read, modification_time, size, entry);
+        }
+
+        if (!is_read && !FileX(entry_name).exists()) {
+            if (is_known) {
+                desktop_file_names_.erase(desktop_file_names_.begin() + location);
+                desktop_entries_.erase(desktop_entries_.begin() + location);
+                are_read_.erase(are_read_.begin() + location);
+            }
+        } else if (is_known) {
+            desktop_entries_[location] = entry;
+            are_read_[location] = is_read;
+        } else {
+            desktop_file_names_.push_back(entry_name);
+            desktop_entries_.push_back(entry);
+            are_read_.push_back(is_read);
+        }
+    }
+
+    classifyDesktopEntries();
+}
+
+void Menu::classifyDesktopEntries()
+{
+    if (has_unclassified_subcategory_) {
+        subcategories_.pop_back();
+    }
+    for (auto &subcategory : subcategories_) {
+        subcategory.drawsFrom(&desktop_entries_);
+        subcategory.clearDesktopEntries();
+    }
+    unclassified_subcategory_.drawsFrom(&desktop_entries_);
+    unclassified_subcategory_.clearDesktopEntries();
+    summary_ = Stats();
+    if (manifest_) {
+        summary_.addManifestHits(manifest_hits_);
+        summary_.addManifestMisses(manifest_misses_);
+    }
+
+    for (size_t i = 0; i < desktop_file_names_.size(); ++i) {
+        addDesktopEntry(i);
     }
 
     subcategories_.push_back(unclassified_subcategory_);
+    has_unclassified_subcategory_ = true;
+}
+
+bool Menu::readDesktopEntry(const std::string &entry_name, xdg::DesktopEntry *entry) const
+{
+    Trace::Span span(trace_, "parse", "desktop_entry");
+    span.annotate("file", entry_name);
+    std::string content;
+    if (!FileX(entry_name).readAll(&content)) {
+        return false;
+    }
+    entry->hasLanguage(language_);
+    entry->parse(content);
+    return true;
+}
+
+// Desktop files that couldn't be read, or whose status is unknown, are left out of the manifest
+void Menu::recordInManifest(const std::string &entry_name, bool is_read, long long modification_time, long long size, const xdg::DesktopEntry &entry)
+{
+    if (is_read && modification_time != 0) {
+        manifest_->add(entry_name, modification_time, size, entry);
+    } else {
+        manifest_->remove(entry_name);
+    }
 }
 
-void Menu::addDesktopEntry(const std::string &entry_name)
+// Subcategories hold the entry's position in the pool of desktop entries, so it is never copied however many accept it
+void Menu::addDesktopEntry(size_t index)
 {
-    std::vector<std::string> lines;
-    if (!FileX(entry_name).readLines(&lines)) {
+    const auto &entry_name = desktop_file_names_[index];
+    const auto &entry = desktop_entries_[index];
+    if (!are_read_[index]) {
         summary_.addUnparsedFile(entry_name);
         return;
     }
-    xdg::DesktopEntry entry;
-    entry.hasLanguage(language_);
-    entry.parse(lines);
 
     if (!entry.display()) {
         summary_.addSuppressedFile(entry_name);
@@ -115,64 +261,141 @@ void Menu::addDesktopEntry(const std::string &entry_name)
         return;
     }
 
-    bool classified = classify(entry);
+    bool classified = classify(index);
     if (classified) {
         summary_.addClassifiedFile(entry_name);
     } else {
-        unclassified_subcategory_.addDesktopEntry(entry);
+        unclassified_subcategory_.addDesktopEntry(index);
         summary_.addUnclassifiedFile(entry_name);
         summary_.addUnhandledClassifications(entry.categories());
     }
 }
 
-bool Menu::classify(const xdg::DesktopEntry &entry)
+// The entry's categories are looked up once into a set, so that a repeated category is visited once
+// Only the subcategories that accept one of those categories are visited, however many the menu has
+bool Menu::classify(size_t index)
 {
-    bool classified = false;
-
-    for (auto &subcategory : subcategories_) {
-        if (entry.isAnyOf(subcategory.classificationNames())) {
-            classified = true;
-            subcategory.addDesktopEntry(entry);
+    CategorySet categories;
+    desktop_entries_[index].eachCategory([this, &categories](const LineView &category) {
+        size_t atom;
+        if (category_atoms_.find(category, &atom) && atom < subcategories_by_atom_.size()) {
+            categories.insert(atom);
         }
+    });
+
+    std::vector<size_t> positions;
+    categories.eachAtom([this, &positions](size_t atom) {
+        const auto &accepting = subcategories_by_atom_[atom];
+        positions.insert(positions.end(), accepting.begin(), accepting.end());
+    });
+
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    for (auto position : positions) {
+        subcategories_[position].addDesktopEntry(index);
     }
 
-    return classified;
+    return !positions.empty();
 }
 
+// Each entry's collation key is computed once, however many subcategories it is in
 void Menu::sort()
 {
+    std::vector<std::string> collation_keys(desktop_entries_.size());
+    std::vector<char> are_keyed(desktop_entries_.size(), false);
+    for (const auto &group : subcategories_) {
+        for (auto index : group.desktopEntryIndices()) {
+            if (!are_keyed[index]) {
+                collation_keys[index] = StringX(desktop_entries_[index].name()).collationKey();
+                are_keyed[index] = true;
+            }
+        }
+    }
+
     for (auto &group : subcategories_) {
-        group.sortDesktopEntries();
+        group.sortDesktopEntries(collation_keys);
     }
 }
 
 std::vector<std::unique_ptr<representation::RepresentationInterface>> Menu::representations() const
 {
     std::vector<std::unique_ptr<representation::RepresentationInterface>> representations;
-    auto menu_start = std::unique_ptr<representation::RepresentationInterface> { new representation::MenuStart };
-    representations.push_back(std::move(menu_start));
+    eachRepresentation([&representations](std::unique_ptr<representation::RepresentationInterface> representation) {
+        representations.push_back(std::move(representation));
+    });
+    return representations;
+}
+
+// Each representation is appended as it is created, so the menu is never held as a list of representations
+void Menu::transform(const transformer::TransformerInterface &transformer, std::string *output) const
+{
+    eachRepresentation([&transformer, output](std::unique_ptr<representation::RepresentationInterface> representation) {
+        representation->visit(transformer, output);
+        output->push_back('\n');
+    });
+}
 
+// Every icon is searched before any representation is built, each name once, on up to the registered number of threads
+std::unordered_map<std::string, std::string> Menu::resolvedIconNames() const
+{
+    std::vector<std::string> icon_names;
+    std::unordered_set<std::string> known_icon_names;
+    auto addIconName = [&icon_names, &known_icon_names](const std::string &icon_name) {
+        if (known_icon_names.insert(icon_name).second) {
+            icon_names.push_back(icon_name);
+        }
+    };
     for (const auto &subcategory : subcategories_) {
         if (subcategory.hasEntries()) {
-            auto icon_name = icon_searcher_->resolvedName(subcategory.iconName());
-            auto start = std::unique_ptr<representation::RepresentationInterface> { new representation::SubcategoryStart(subcategory.displayName(), icon_name) };
-            representations.push_back(std::move(start));
-
-            auto entries = subcategory.desktopEntries();
-            for (const auto &entry : entries) {
-                auto icon_name = icon_searcher_->resolvedName(entry.icon());
-                auto program = std::unique_ptr<representation::RepresentationInterface> { new representation::Program(entry.name(), icon_name, entry.executable(), entry.comment()) };
-                representations.push_back(std::move(program));
+            addIconName(subcategory.iconName());
+            for (auto index : subcategory.desktopEntryIndices()) {
+                addIconName(desktop_entries_[index].icon());
             }
+        }
+    }
+
+    // The names are split into one batch per thread, and each batch is searched together
+    std::vector<std::string> resolved_names(icon_names.size());
+    auto batch_count = std::max<size_t>(1, std::min(jobs_, icon_names.size()));
+    parallel::forEach(batch_count, jobs_, [&](size_t batch) {
+        auto begin = icon_names.size() * batch / batch_count;
+        auto end = icon_names.size() * (batch + 1) / batch_count;
+        Trace::Span span(trace_, "resolve", "icon");
+        span.annotate("icons", std::to_string(end - begin));
+        auto batch_names = std::vector<std::string>(icon_names.begin() + begin, icon_names.begin() + end);
+        auto batch_resolved_names = icon_searcher_->resolveAll(batch_names);
+        std::copy(batch_resolved_names.begin(), batch_resolved_names.end(), resolved_names.begin() + begin);
+    });
+
+    std::unordered_map<std::string, std::string> resolved_icon_names;
+    resolved_icon_names.reserve(icon_names.size());
+    for (size_t i = 0; i < icon_names.size(); ++i) {
+        resolved_icon_names[icon_names[i]] = resolved_names[i];
+    }
+    return resolved_icon_names;
+}
 
-            auto end = std::unique_ptr<representation::RepresentationInterface> { new representation::SubcategoryEnd(subcategory.displayName()) };
-            representations.push_back(std::move(end));
+void Menu::eachRepresentation(const std::function<void(std::unique_ptr<representation::RepresentationInterface>)> &visitor) const
+{
+    auto resolved_icon_names = resolvedIconNames();
+    visitor(std::unique_ptr<representation::RepresentationInterface> { new representation::MenuStart });
+
+    for (const auto &subcategory : subcategories_) {
+        if (subcategory.hasEntries()) {
+            const auto &icon_name = resolved_icon_names[subcategory.iconName()];
+            visitor(std::unique_ptr<representation::RepresentationInterface> { new representation::SubcategoryStart(subcategory.displayName(), icon_name) });
+
+            for (auto index : subcategory.desktopEntryIndices()) {
+                const auto &entry = desktop_entries_[index];
+                const auto &icon_name = resolved_icon_names[entry.icon()];
+                visitor(std::unique_ptr<representation::RepresentationInterface> { new representation::Program(entry.name(), icon_name, entry.executable(), entry.comment()) });
+            }
+
+            visitor(std::unique_ptr<representation::RepresentationInterface> { new representation::SubcategoryEnd(subcategory.displayName()) });
         }
     }
 
-    auto menu_end = std::unique_ptr<representation::RepresentationInterface> { new representation::MenuEnd };
-    representations.push_back(std::move(menu_end));
-    return representations;
+    visitor(std::unique_ptr<representation::RepresentationInterface> { new representation::MenuEnd });
 }
 
 } // namespace amm
@@ -57,6 +57,13 @@ std::string help()
     stream << "                                icon theme is used if no theme name is given." << std::endl;
     stream << "      --language [NAME]       The language for which the menu would be build." << std::endl;
     stream << "                                Defaults to the system default." << std::endl;
+    stream << "  -j, --jobs [COUNT]          Read desktop files and search icons on COUNT" << std::endl;
+    stream << "                                threads. The menu is the same for any number" << std::endl;
+    stream << "                                of threads, from 1 to 1024. [Default: 1]" << std::endl;
+    stream << "      --watch                 Keep running, and update the menu whenever desktop" << std::endl;
+    stream << "                                files are added, changed or removed." << std::endl;
+    stream << "      --trace [FILE]          Write the time taken by each stage, desktop file" << std::endl;
+    stream << "                                and icon search to FILE as Chrome trace events." << std::endl;
     stream << "  -v  --verbose               Verbose output" << std::endl;
     stream << "      --help                  Show this help" << std::endl;
     stream << "      --version               Show version information" << std::endl;
@@ -136,6 +143,20 @@ std::string badOutputFile(const std::string &file_name)
     return stream.str();
 }
 
+std::string badTraceFile(const std::string &file_name)
+{
+    std::stringstream stream;
+    stream << "Couldn't write trace file: " << file_name;
+    return stream.str();
+}
+
+std::string unchangedOutputFile(const std::string &file_name)
+{
+    std::stringstream stream;
+    stream << "Unchanged " << file_name << " (the menu is the same)";
+    return stream.str();
+}
+
 std::string backupFile(const std::string &file_name, const std::string &backup_file_name)
 {
     std::stringstream stream;
@@ -143,5 +164,31 @@ std::string backupFile(const std::string &file_name, const std::string &backup_f
     return stream.str();
 }
 
+std::string badBackupFile(const std::string &backup_file_name)
+{
+    std::stringstream stream;
+    stream << "Couldn't create backup file: " << backup_file_name << ". The output file is unchanged.";
+    return stream.str();
+}
+
+std::string watchUnavailable()
+{
+    return "Couldn't watch desktop file directories for changes.";
+}
+
+std::string watching(const std::string &directory_names)
+{
+    std::stringstream stream;
+    stream << "Watching " << directory_names;
+    return stream.str();
+}
+
+std::string updatedOutputFile(const std::string &file_name, size_t changed_file_count)
+{
+    std::stringstream stream;
+    stream << "Updated " << file_name << " (" << changed_file_count << " changed desktop files)";
+    return stream.str();
+}
+
 } // namespace messages
 } // namespace amm
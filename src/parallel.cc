@@ -0,0 +1,64 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "parallel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace amm {
+namespace parallel {
+
+void forEach(size_t count, size_t jobs, const std::function<void(size_t)> &task)
+{
+    if (jobs > count) {
+        jobs = count;
+    }
+
+    if (jobs <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_index(0);
+    auto work = [&]() {
+        size_t i;
+        while ((i = next_index++) < count) {
+            task(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(jobs - 1);
+    for (size_t worker = 1; worker < jobs; ++worker) {
+        workers.push_back(std::thread(work));
+    }
+    work();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace parallel
+} // namespace amm
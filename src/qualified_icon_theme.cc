@@ -19,70 +19,27 @@
 #include <string>
 #include <vector>
 
-#include "stringx.h"
 #include "filex.h"
-#include "directoryx.h"
+#include "icon_theme_registry.h"
 #include "system_environment.h"
-#include "xdg/icon_theme.h"
 #include "qualified_icon_theme.h"
 
 namespace amm {
 
-QualifiedIconTheme::QualifiedIconTheme(const SystemEnvironment &environment, const std::string &theme_name) : theme_name_(theme_name)
+static std::vector<std::string> existingDirectories(const std::vector<std::string> &directory_names)
 {
-    auto theme_directories = environment.iconThemeDirectories();
-
-    for (const auto &dir : theme_directories) {
+    std::vector<std::string> existing_directories;
+    for (const auto &dir : directory_names) {
         if (FileX(dir).exists()) {
-            theme_search_paths_.push_back(dir);
-        }
-    }
-}
-
-xdg::IconTheme QualifiedIconTheme::iconThemeFromName(const std::string &theme_name)
-{
-    for (const auto &path : theme_search_paths_) {
-        DirectoryX directory(path);
-
-        if (directory.isValid()) {
-            auto entries = directory.allEntries();
-            for (const auto &entry : entries) {
-                auto name = entry.name();
-                if (entry.isDirectory() && name != "." && name != "..") {
-                    auto full_path = StringX(path).terminateWith("/") + StringX(entry.name()).terminateWith("/") + "index.theme";
-                    std::vector<std::string> lines;
-
-                    if (FileX(full_path).readLines(&lines)) {
-                        auto xdg_theme = xdg::IconTheme(lines).internalNameIs(entry.name());
-                        if (xdg_theme.isNamed(theme_name)) {
-                            return xdg_theme;
-                        }
-                    }
-                }
-            }
+            existing_directories.push_back(dir);
         }
     }
-
-    std::vector<std::string> empty_lines;
-    return xdg::IconTheme(empty_lines);
+    return existing_directories;
 }
 
-xdg::IconTheme QualifiedIconTheme::currentIconThemeFromName()
+QualifiedIconTheme::QualifiedIconTheme(const SystemEnvironment &environment, const std::string &theme_name) :
+        theme_name_(theme_name), theme_search_paths_(existingDirectories(environment.iconThemeDirectories())), registry_(theme_search_paths_)
 {
-    return iconThemeFromName(theme_name_);
-}
-
-std::vector<xdg::IconTheme> QualifiedIconTheme::themeWithParent()
-{
-    std::vector<xdg::IconTheme> icon_themes;
-    auto icon_theme = currentIconThemeFromName();
-    icon_themes.push_back(icon_theme);
-
-    auto parent_themes = icon_theme.parents();
-    for (const auto &theme : parent_themes) {
-        icon_themes.push_back(iconThemeFromName(theme));
-    }
-    return icon_themes;
 }
 
 } // namespace amm
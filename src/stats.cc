@@ -99,6 +99,10 @@ std::string Stats::details(const std::string &summary_type)
         if (unhandled_classifications_.size() > 0) {
             stream << std::endl << "Unhandled classifications: " << VectorX(unhandledClassifications()).join(", ");
         }
+
+        if (manifest_hits_ + manifest_misses_ > 0) {
+            stream << std::endl << "Manifest: " << manifest_hits_ << " unchanged, " << manifest_misses_ << " read";
+        }
     }
 
     return stream.str();
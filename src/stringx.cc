@@ -18,6 +18,9 @@
 
 #include "stringx.h"
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -57,6 +60,24 @@ std::string StringX::encode() const
     return result;
 }
 
+std::string StringX::escapeField() const
+{
+    std::string result;
+    result.reserve(string_.size());
+    for (auto c : string_) {
+        if (c == '\\') {
+            result += "\\\\";
+        } else if (c == '\t') {
+            result += "\\t";
+        } else if (c == '\n') {
+            result += "\\n";
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
 std::string StringX::trim() const
 {
     auto whitespace = " \t\n";
@@ -72,6 +93,32 @@ std::string StringX::trim() const
     return string_.substr(begin, range);
 }
 
+// 64-bit FNV-1a, stable across runs and platforms
+std::string StringX::digest() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto &c : string_) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+std::string StringX::collationKey() const
+{
+    std::string key(string_.size() * 2 + 1, '\0');
+    auto length = strxfrm(&key[0], string_.c_str(), key.size());
+    if (length >= key.size()) {
+        key.resize(length + 1);
+        strxfrm(&key[0], string_.c_str(), key.size());
+    }
+    key.resize(length);
+    return key;
+}
+
 std::vector<std::string> StringX::split(const std::string &delimeter) const
 {
     auto raw = StringX(string_).terminateWith(delimeter);
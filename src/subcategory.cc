@@ -18,38 +18,90 @@
 
 #include "subcategory.h"
 
+#include <cassert>
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <utility>
 #include <algorithm>
 
+#include "stringx.h"
 #include "xdg/desktop_entry.h"
 
 namespace amm {
 
 Subcategory::Subcategory(const std::string &display_name, const std::string &icon_name, const std::string &classification_name) :
-        display_name_(display_name), icon_name_(icon_name)
+        display_name_(display_name), icon_name_(icon_name), pool_(nullptr)
 {
     classification_names_.push_back(classification_name);
 }
 
 Subcategory::Subcategory(const std::string &display_name, const std::string &icon_name, const std::vector<std::string> &classification_names) :
-        display_name_(display_name), icon_name_(icon_name), classification_names_(classification_names) {}
+        display_name_(display_name), icon_name_(icon_name), classification_names_(classification_names), pool_(nullptr) {}
 
-bool Subcategory::hasEntries() const
+std::vector<xdg::DesktopEntry> Subcategory::desktopEntries() const
 {
-    return !desktopEntries().empty();
+    assert(pool_ != nullptr || desktop_entry_indices_.empty());
+    std::vector<xdg::DesktopEntry> desktop_entries;
+    desktop_entries.reserve(desktop_entry_indices_.size());
+    for (auto index : desktop_entry_indices_) {
+        desktop_entries.push_back((*pool_)[index]);
+    }
+    return desktop_entries;
 }
 
-void Subcategory::addDesktopEntry(const xdg::DesktopEntry &desktop_entry)
+void Subcategory::addDesktopEntry(size_t index)
 {
-    desktop_entries_.push_back(desktop_entry);
+    assert(pool_ != nullptr);
+    const auto &entry = (*pool_)[index];
+    auto hash = entry.identityHash();
+    auto candidates = indices_by_hash_.equal_range(hash);
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if ((*pool_)[it->second] == entry) {
+            return;
+        }
+    }
+    indices_by_hash_.insert(std::make_pair(hash, index));
+    desktop_entry_indices_.push_back(index);
 }
 
+void Subcategory::sortDesktopEntries(const std::vector<std::string> &collation_keys)
+{
+    std::vector<KeyedIndex> keyed_indices;
+    keyed_indices.reserve(desktop_entry_indices_.size());
+    for (auto index : desktop_entry_indices_) {
+        keyed_indices.push_back(std::make_pair(&collation_keys[index], index));
+    }
+    sortKeyed(&keyed_indices);
+}
+
+// Only this subcategory's own entries are keyed
 void Subcategory::sortDesktopEntries()
 {
-    std::sort(desktop_entries_.begin(), desktop_entries_.end());
-    auto it = std::unique(desktop_entries_.begin(), desktop_entries_.end());
-    desktop_entries_.resize(std::distance(desktop_entries_.begin(), it));
+    assert(pool_ != nullptr || desktop_entry_indices_.empty());
+    std::vector<std::string> collation_keys;
+    collation_keys.reserve(desktop_entry_indices_.size());
+    for (auto index : desktop_entry_indices_) {
+        collation_keys.push_back(StringX((*pool_)[index].name()).collationKey());
+    }
+
+    std::vector<KeyedIndex> keyed_indices;
+    keyed_indices.reserve(desktop_entry_indices_.size());
+    for (size_t i = 0; i < desktop_entry_indices_.size(); ++i) {
+        keyed_indices.push_back(std::make_pair(&collation_keys[i], desktop_entry_indices_[i]));
+    }
+    sortKeyed(&keyed_indices);
+}
+
+void Subcategory::sortKeyed(std::vector<KeyedIndex> *keyed_indices)
+{
+    std::sort(keyed_indices->begin(), keyed_indices->end(), [](const KeyedIndex &a, const KeyedIndex &b) {
+        auto order = a.first->compare(*b.first);
+        return order < 0 || (order == 0 && a.second < b.second);
+    });
+    for (size_t i = 0; i < keyed_indices->size(); ++i) {
+        desktop_entry_indices_[i] = (*keyed_indices)[i].second;
+    }
 }
 
 } // namespace amm
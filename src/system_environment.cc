@@ -47,6 +47,14 @@ SystemEnvironment::SystemEnvironment()
         xdg_data_dirs_ = "/usr/local/share:/usr/share";
     }
 
+    // An empty or relative XDG_CACHE_HOME is ignored, as the XDG Base Directory specification asks
+    auto *xdg_cache_home = std::getenv("XDG_CACHE_HOME");
+    if (xdg_cache_home != nullptr && xdg_cache_home[0] == '/') {
+        xdg_cache_home_ = xdg_cache_home;
+    } else {
+        xdg_cache_home_ = home_ + "/.cache";
+    }
+
     language_ = getLanguageWith(std::getenv("LANGUAGE"));
     if (language_ == "")  {
         language_ = getLanguageWith(std::getenv("LC_ALL"));
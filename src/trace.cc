@@ -0,0 +1,175 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trace.h"
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "filex.h"
+
+namespace amm {
+
+static bool isContinuation(const std::string &text, size_t position, unsigned char low = 0x80, unsigned char high = 0xbf)
+{
+    if (position >= text.size()) {
+        return false;
+    }
+    auto c = static_cast<unsigned char>(text[position]);
+    return c >= low && c <= high;
+}
+
+// The length of the well-formed UTF-8 sequence starting at position, or 0 when there is none
+// Overlong forms, surrogates and code points beyond U+10FFFF aren't well-formed
+static size_t utf8SequenceLength(const std::string &text, size_t position)
+{
+    auto lead = static_cast<unsigned char>(text[position]);
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        return isContinuation(text, position + 1) ? 2 : 0;
+    }
+    if (lead >= 0xe0 && lead <= 0xef) {
+        auto low = static_cast<unsigned char>(lead == 0xe0 ? 0xa0 : 0x80);
+        auto high = static_cast<unsigned char>(lead == 0xed ? 0x9f : 0xbf);
+        return isContinuation(text, position + 1, low, high) && isContinuation(text, position + 2) ? 3 : 0;
+    }
+    if (lead >= 0xf0 && lead <= 0xf4) {
+        auto low = static_cast<unsigned char>(lead == 0xf0 ? 0x90 : 0x80);
+        auto high = static_cast<unsigned char>(lead == 0xf4 ? 0x8f : 0xbf);
+        return isContinuation(text, position + 1, low, high) && isContinuation(text, position + 2) &&
+            isContinuation(text, position + 3) ? 4 : 0;
+    }
+    return 0;
+}
+
+// Bytes that aren't part of well-formed UTF-8, such as those of a file name in another encoding, are written as \u00XX
+static std::string escaped(const std::string &text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        auto c = static_cast<unsigned char>(text[i]);
+        switch (c) {
+        case '"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '\n': result += "\\n"; break;
+        case '\t': result += "\\t"; break;
+        default:
+            auto length = c < 0x80 ? 1 : utf8SequenceLength(text, i);
+            if (c < 0x20 || length == 0) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                result += buffer;
+            } else {
+                result.append(text, i, length);
+                i += length - 1;
+            }
+        }
+    }
+    return result;
+}
+
+Trace::Span::Span(Trace *trace, const std::string &name, const std::string &category) :
+        trace_(trace)
+{
+    if (trace_ != nullptr) {
+        name_ = name;
+        category_ = category;
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+void Trace::Span::annotate(const std::string &key, const std::string &value)
+{
+    if (trace_ != nullptr) {
+        arguments_.push_back(std::make_pair(key, value));
+    }
+}
+
+Trace::Span::~Span()
+{
+    if (trace_ == nullptr) {
+        return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    Event event;
+    event.name = std::move(name_);
+    event.category = std::move(category_);
+    event.arguments = std::move(arguments_);
+    event.start_us = std::chrono::duration<double, std::micro>(start_ - trace_->origin_).count();
+    event.duration_us = std::chrono::duration<double, std::micro>(end - start_).count();
+    trace_->record(std::move(event), std::this_thread::get_id());
+}
+
+void Trace::record(Event event, std::thread::id thread_id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto thread = threads_.insert(std::make_pair(thread_id, static_cast<int>(threads_.size()) + 1)).first;
+    event.thread = thread->second;
+    events_.push_back(std::move(event));
+}
+
+size_t Trace::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+// Complete ("X") events in the JSON object format understood by chrome://tracing and Perfetto
+std::string Trace::json() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::stringstream stream;
+    stream.precision(3);
+    stream << std::fixed;
+    auto pid = getpid();
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    stream << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":1,\"args\":{\"name\":\"amm\"}}";
+    for (const auto &event : events_) {
+        stream << ",\n{\"name\":\"" << escaped(event.name) << "\",\"cat\":\"" << escaped(event.category)
+               << "\",\"ph\":\"X\",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+               << ",\"pid\":" << pid << ",\"tid\":" << event.thread;
+        if (!event.arguments.empty()) {
+            stream << ",\"args\":{";
+            for (size_t i = 0; i < event.arguments.size(); ++i) {
+                stream << (i == 0 ? "" : ",") << "\"" << escaped(event.arguments[i].first) << "\":\"" << escaped(event.arguments[i].second) << "\"";
+            }
+            stream << "}";
+        }
+        stream << "}";
+    }
+    stream << "\n]}";
+
+    return stream.str();
+}
+
+// An earlier trace at the same location is replaced
+bool Trace::save(const std::string &file_name) const
+{
+    remove(file_name.c_str());
+    return FileX(file_name).writeLines({ json() });
+}
+
+} // namespace amm
@@ -16,78 +16,126 @@
   along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <string>
-#include <sstream>
-#include <vector>
-
-#include "stringx.h"
-#include "vectorx.h"
 #include "transformer/jwm.h"
 
+#include <string>
+
 namespace amm {
 namespace transformer {
 
-static std::string removeFieldCode(const std::string &input)
+static void appendEncoded(const std::string &input, std::string *output)
 {
-    std::vector<std::string> result;
-    auto tokens = StringX(input).split(" ");
-
-    for (const auto &token : tokens) {
-        if (!(token.size() >= 1 && token[0] == '%')) {
-            result.push_back(token);
+    for (auto c : input) {
+        switch (c) {
+            case '&' : output->append("&amp;");  break;
+            case '\"': output->append("&quot;"); break;
+            case '\'': output->append("&apos;"); break;
+            case '<' : output->append("&lt;");   break;
+            case '>' : output->append("&gt;");   break;
+            default  : output->push_back(c);     break;
         }
     }
+}
+
+// Keeps the space separated tokens that aren't field codes (%f, %U ...), as splitting on spaces would
+static void appendWithoutFieldCodes(const std::string &input, std::string *output)
+{
+    if (input.empty() || input[0] == ' ') {
+        return;
+    }
 
-    return VectorX(result).join(" ");
+    auto is_first = true;
+    size_t start = 0;
+    while (start < input.size()) {
+        auto end = input.find(' ', start);
+        if (end == std::string::npos) {
+            end = input.size();
+        }
+        if (!(end > start && input[start] == '%')) {
+            if (!is_first) {
+                output->push_back(' ');
+            }
+            output->append(input, start, end - start);
+            is_first = false;
+        }
+        start = end + 1;
+    }
 }
 
 std::string Jwm::transform(const representation::MenuStart &entry) const
 {
-    std::stringstream stream;
-    stream << "<JWM>"
-        << std::endl
-        << "    <!--" << entry.name() << "-->";
-    return stream.str();
+    std::string output;
+    transform(entry, &output);
+    return output;
 }
 
 std::string Jwm::transform(const representation::MenuEnd &entry) const
 {
-    std::stringstream stream;
-    stream << "    <!--" << entry.name() << "-->"
-        << std::endl
-        << "</JWM>";
-    return stream.str();
+    std::string output;
+    transform(entry, &output);
+    return output;
 }
 
 std::string Jwm::transform(const representation::SubcategoryStart &entry) const
 {
-    std::stringstream stream;
-    stream << "    <Menu "
-        << "label=\"" << StringX(entry.name()).encode()
-        << "\" icon=\"" << entry.icon()
-        << "\">";
-    return stream.str();
+    std::string output;
+    transform(entry, &output);
+    return output;
 }
 
 std::string Jwm::transform(const representation::SubcategoryEnd &entry) const
 {
-    std::stringstream stream;
-    stream << "        <!--" << entry.name() << "-->"
-        << std::endl
-        << "    </Menu>";
-    return stream.str();
+    std::string output;
+    transform(entry, &output);
+    return output;
 }
 
 std::string Jwm::transform(const representation::Program &entry) const
 {
-    std::stringstream stream;
-    stream << "        <Program "
-        << "label=\"" << StringX(entry.name()).encode()
-        << "\" icon=\"" << StringX(entry.icon()).encode()
-        << "\">"
-        << removeFieldCode(entry.executable())
-        << "</Program>";
-    return stream.str();
+    std::string output;
+    transform(entry, &output);
+    return output;
+}
+
+void Jwm::transform(const representation::MenuStart &entry, std::string *output) const
+{
+    output->append("<JWM>\n    <!--");
+    output->append(entry.name());
+    output->append("-->");
+}
+
+void Jwm::transform(const representation::MenuEnd &entry, std::string *output) const
+{
+    output->append("    <!--");
+    output->append(entry.name());
+    output->append("-->\n</JWM>");
+}
+
+void Jwm::transform(const representation::SubcategoryStart &entry, std::string *output) const
+{
+    output->append("    <Menu label=\"");
+    appendEncoded(entry.name(), output);
+    output->append("\" icon=\"");
+    output->append(entry.icon());
+    output->append("\">");
+}
+
+void Jwm::transform(const representation::SubcategoryEnd &entry, std::string *output) const
+{
+    output->append("        <!--");
+    output->append(entry.name());
+    output->append("-->\n    </Menu>");
+}
+
+void Jwm::transform(const representation::Program &entry, std::string *output) const
+{
+    output->append("        <Program label=\"");
+    appendEncoded(entry.name(), output);
+    output->append("\" icon=\"");
+    appendEncoded(entry.icon(), output);
+    output->append("\">");
+    appendWithoutFieldCodes(entry.executable(), output);
+    output->append("</Program>");
 }
 
 } // namespace transformer
@@ -18,43 +18,240 @@
 
 #include "xdg/desktop_entry.h"
 
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <vector>
 #include <algorithm>
 
-#include "stringx.h"
-#include "xdg/entry.h"
+#include "line_view.h"
 
 namespace amm {
 namespace xdg {
 
+namespace {
+
+enum KeyMatch { kNoMatch, kPlainMatch, kLanguageMatch };
+
+struct Field
+{
+    const char *key;
+    size_t key_length;
+    LineView plain;
+    LineView localized;
+    bool is_localized;
+};
+
+} // namespace
+
+static const char kSectionName[] = "Desktop Entry";
+
+// Matches both Key and Key[language], the latter only when a language is set
+static KeyMatch matchKey(const LineView &key, const Field &field, const std::string &language)
+{
+    if (!key.startsWith(field.key, field.key_length)) {
+        return kNoMatch;
+    }
+    if (key.size() == field.key_length) {
+        return kPlainMatch;
+    }
+    if (language.empty() || key.size() != field.key_length + language.size() + 2) {
+        return kNoMatch;
+    }
+    auto suffix = key.begin() + field.key_length;
+    if (suffix[0] != '[' || key.end()[-1] != ']' || std::memcmp(suffix + 1, language.data(), language.size()) != 0) {
+        return kNoMatch;
+    }
+    return kLanguageMatch;
+}
+
+static LineView viewOf(const std::string &text)
+{
+    return LineView(text.data(), text.data() + text.size());
+}
+
+// Keys that aren't in the file leave empty views without a buffer, which memcmp mustn't be given
+static bool isLess(const LineView &a, const LineView &b)
+{
+    auto length = std::min(a.size(), b.size());
+    auto result = length == 0 ? 0 : std::memcmp(a.begin(), b.begin(), length);
+    return result < 0 || (result == 0 && a.size() < b.size());
+}
+
+static bool isSame(const LineView &a, const LineView &b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.begin(), b.begin(), a.size()) == 0);
+}
+
+// Splits like StringX::split(";"): a trailing ';' ends the last category, and a leading ';' leaves none
+static std::vector<LineView> splitCategories(const LineView &value)
+{
+    std::vector<LineView> categories;
+    if (value.empty() || *value.begin() == ';') {
+        return categories;
+    }
+
+    auto start = value.begin();
+    while (start != value.end()) {
+        auto delimiter = std::find(start, value.end(), ';');
+        categories.push_back(LineView(start, delimiter));
+        start = delimiter == value.end() ? delimiter : delimiter + 1;
+    }
+    return categories;
+}
+
+DesktopEntry::DesktopEntry() : text_(4, '\0'), icon_at_(1), executable_at_(2), comment_at_(3), categories_at_(4), display_(true)
+{
+}
+
+DesktopEntry::DesktopEntry(const std::string &name, const std::string &icon, const std::string &executable,
+                           const std::vector<std::string> &categories, const std::string &comment, bool display) :
+        display_(display)
+{
+    std::vector<LineView> category_views;
+    for (const auto &category : categories) {
+        category_views.push_back(viewOf(category));
+    }
+    store(viewOf(name), viewOf(icon), viewOf(executable), viewOf(comment), category_views);
+}
+
+void DesktopEntry::store(const LineView &name, const LineView &icon, const LineView &executable, const LineView &comment,
+                         std::vector<LineView> categories)
+{
+    std::sort(categories.begin(), categories.end(), isLess);
+
+    auto size = name.size() + icon.size() + executable.size() + comment.size() + 4;
+    for (const auto &category : categories) {
+        size += category.size() + 1;
+    }
+
+    std::string text;
+    text.reserve(size);
+    auto append = [&text](const LineView &value) {
+        if (!value.empty()) {
+            text.append(value.begin(), value.size());
+        }
+        text.push_back('\0');
+        return static_cast<uint32_t>(text.size());
+    };
+    icon_at_ = append(name);
+    executable_at_ = append(icon);
+    comment_at_ = append(executable);
+    categories_at_ = append(comment);
+    for (const auto &category : categories) {
+        append(category);
+    }
+    text_.swap(text);
+}
+
 void DesktopEntry::parse(const std::vector<std::string> &lines)
 {
-    Entry xdg_entry(lines, language_);
-    xdg_entry.parse();
-    name_ = xdg_entry.under("Desktop Entry", "Name");
-    icon_ = xdg_entry.under("Desktop Entry", "Icon");
-    executable_ = xdg_entry.under("Desktop Entry", "Exec");
-    categories_ = StringX(xdg_entry.under("Desktop Entry", "Categories")).split(";");
-    comment_ = xdg_entry.under("Desktop Entry", "Comment");
-    std::string display_raw = xdg_entry.under("Desktop Entry", "NoDisplay");
-    display_ = display_raw != "true" && display_raw != "1";
-    std::sort(categories_.begin(), categories_.end());
+    std::string content;
+    for (const auto &line : lines) {
+        content += line;
+        content += '\n';
+    }
+    parse(content);
+}
+
+void DesktopEntry::parse(const std::string &content)
+{
+    parse(content.data(), content.data() + content.size());
+}
+
+void DesktopEntry::parse(const char *begin, const char *end)
+{
+    enum { kName, kIcon, kExec, kCategories, kComment, kNoDisplay, kFieldCount };
+    Field fields[kFieldCount] = {
+        { "Name", 4, LineView(), LineView(), false },
+        { "Icon", 4, LineView(), LineView(), false },
+        { "Exec", 4, LineView(), LineView(), false },
+        { "Categories", 10, LineView(), LineView(), false },
+        { "Comment", 7, LineView(), LineView(), false },
+        { "NoDisplay", 9, LineView(), LineView(), false },
+    };
+
+    bool in_section = false;
+    LineScanner scanner(begin, end);
+    LineView raw_line;
+    while (scanner.next(&raw_line)) {
+        auto line = raw_line.trim();
+        if (line.empty() || *line.begin() == '#') {
+            continue;
+        }
+        if (*line.begin() == '[' && *(line.end() - 1) == ']') {
+            if (in_section) {
+                break;
+            }
+            in_section = LineView(line.begin() + 1, line.end() - 1).is(kSectionName, sizeof(kSectionName) - 1);
+            continue;
+        }
+        if (!in_section) {
+            continue;
+        }
+
+        auto delimiter = line.find('=');
+        if (delimiter == nullptr) {
+            continue;
+        }
+        auto key = LineView(line.begin(), delimiter).trim();
+        for (auto &field : fields) {
+            auto match = matchKey(key, field, language_);
+            if (match == kPlainMatch) {
+                field.plain = LineView(delimiter + 1, line.end()).trim();
+                break;
+            } else if (match == kLanguageMatch) {
+                field.localized = LineView(delimiter + 1, line.end()).trim();
+                field.is_localized = true;
+                break;
+            }
+        }
+    }
+
+    auto value = [&fields](int index) {
+        const auto &field = fields[index];
+        return field.is_localized ? field.localized : field.plain;
+    };
+    auto display = value(kNoDisplay);
+    display_ = !display.is("true", 4) && !display.is("1", 1);
+    store(value(kName), value(kIcon), value(kExec), value(kComment), splitCategories(value(kCategories)));
+}
+
+std::vector<std::string> DesktopEntry::categories() const
+{
+    std::vector<std::string> categories;
+    eachCategory([&categories](const LineView &category) {
+        categories.push_back(category.str());
+    });
+    return categories;
+}
+
+void DesktopEntry::eachCategory(const std::function<void(const LineView&)> &visitor) const
+{
+    auto begin = text_.data() + categories_at_;
+    auto end = text_.data() + text_.size();
+    while (begin != end) {
+        auto category_end = static_cast<const char*>(std::memchr(begin, '\0', end - begin));
+        visitor(LineView(begin, category_end));
+        begin = category_end + 1;
+    }
 }
 
 bool DesktopEntry::operator < (const DesktopEntry &other) const
 {
-    return name_ < other.name_;
+    return isLess(view(0, icon_at_), other.view(0, other.icon_at_));
 }
 
 bool DesktopEntry::operator > (const DesktopEntry &other) const
 {
-    return name_ > other.name_;
+    return other < *this;
 }
 
 bool DesktopEntry::operator == (const DesktopEntry &other) const
 {
-    return name_ == other.name_ && executable_ == other.executable_;
+    return isSame(view(0, icon_at_), other.view(0, other.icon_at_)) &&
+        isSame(view(executable_at_, comment_at_), other.view(other.executable_at_, other.comment_at_));
 }
 
 bool DesktopEntry::operator != (const DesktopEntry &other) const
@@ -62,14 +259,41 @@ bool DesktopEntry::operator != (const DesktopEntry &other) const
     return !(*this == other);
 }
 
+// FNV-1a over the name and executable, the fields that operator== compares
+size_t DesktopEntry::identityHash() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const char *begin, const char *end) {
+        for (auto c = begin; c != end; ++c) {
+            hash ^= static_cast<unsigned char>(*c);
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(text_.data(), text_.data() + icon_at_);
+    mix(text_.data() + executable_at_, text_.data() + comment_at_);
+    return static_cast<size_t>(hash);
+}
+
 bool DesktopEntry::isValid() const
 {
-    return !executable_.empty() && !name_.empty() && !icon_.empty();
+    return icon_at_ > 1 && executable_at_ - icon_at_ > 1 && comment_at_ - executable_at_ > 1;
 }
 
+// The categories are stored sorted, so the first one that isn't less than the type decides
 bool DesktopEntry::isA(const std::string &type) const
 {
-    return std::binary_search(categories_.begin(), categories_.end(), type);
+    auto wanted = viewOf(type);
+    auto begin = text_.data() + categories_at_;
+    auto end = text_.data() + text_.size();
+    while (begin != end) {
+        auto category_end = static_cast<const char*>(std::memchr(begin, '\0', end - begin));
+        auto category = LineView(begin, category_end);
+        if (!isLess(category, wanted)) {
+            return isSame(category, wanted);
+        }
+        begin = category_end + 1;
+    }
+    return false;
 }
 
 bool DesktopEntry::isAnyOf(const std::vector<std::string> &types) const
@@ -22,27 +22,49 @@
 #include <vector>
 #include <map>
 
-#include "xdg/entry_line.h"
+#include "line_view.h"
 
 namespace amm {
 namespace xdg {
 
+static std::string joinLines(const std::vector<std::string> &lines)
+{
+    std::string content;
+    for (const auto &line : lines) {
+        content += line;
+        content += '\n';
+    }
+    return content;
+}
+
+Entry::Entry(const std::vector<std::string> &lines, const std::string &language) : content_(joinLines(lines)), language_(language) { }
+
+Entry::Entry(const std::vector<std::string> &lines) : content_(joinLines(lines)) { }
+
 void Entry::parse()
 {
     std::map< std::string, std::string > entry;
     std::string current_section = "";
 
-    for (const auto &raw_line : lines_) {
-        EntryLine line(raw_line);
-        if (line.isDeclaration()) {
-            result_[current_section] = entry;
+    LineScanner scanner(content_);
+    LineView raw_line;
+    while (scanner.next(&raw_line)) {
+        auto line = raw_line.trim();
+        if (line.empty()) {
+            continue;
+        }
+        if (*line.begin() == '[' && *(line.end() - 1) == ']') {
+            result_[current_section].swap(entry);
             entry.clear();
-            current_section = line.declaration();
-        } else if (line.isAssignment()) {
-            entry[line.key()] = line.value();
+            current_section = LineView(line.begin() + 1, line.find(']')).str();
+        } else {
+            auto delimiter = line.find('=');
+            if (delimiter != nullptr) {
+                entry[LineView(line.begin(), delimiter).trim().str()] = LineView(delimiter + 1, line.end()).trim().str();
+            }
         }
     }
-    result_[current_section] = entry;
+    result_[current_section].swap(entry);
 }
 
 std::string Entry::under(const std::string &section_name, const std::string &key_name)
@@ -92,6 +92,19 @@ IconSubdirectory& IconSubdirectory::location(const std::string &location)
     return *this;
 }
 
+IconSubdirectory& IconSubdirectory::context(const std::string &context)
+{
+    context_ = context;
+    return *this;
+}
+
+bool IconSubdirectory::holdsMenuIcons() const
+{
+    auto context = context_;
+    std::transform(context.begin(), context.end(), context.begin(), ::tolower);
+    return context == "" || context == "applications" || context == "categories";
+}
+
 bool IconSubdirectory::matches(int required_size) const
 {
     if (type_ == FIXED) {
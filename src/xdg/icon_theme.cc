@@ -33,30 +33,43 @@ namespace xdg {
 IconTheme::IconTheme(const std::vector<std::string> &lines) : internal_name_("")
 {
     Entry xdg_entry(lines);
-    xdg_entry.parse();
+    populate(&xdg_entry);
+}
+
+IconTheme::IconTheme(const std::string &content) : internal_name_("")
+{
+    Entry xdg_entry(content);
+    populate(&xdg_entry);
+}
+
+void IconTheme::populate(Entry *xdg_entry)
+{
+    xdg_entry->parse();
 
-    name_ = xdg_entry.under("Icon Theme", "Name");
+    name_ = xdg_entry->under("Icon Theme", "Name");
     auto lower_case_name = name_;
     std::transform(lower_case_name.begin(), lower_case_name.end(), lower_case_name.begin(), ::tolower);
 
-    parents_ = StringX(xdg_entry.under("Icon Theme", "Inherits")).split(",");
+    parents_ = StringX(xdg_entry->under("Icon Theme", "Inherits")).split(",");
     if (parents_.empty() && lower_case_name != "hicolor") {
         parents_.push_back("Hicolor");
     }
 
-    auto directory_names = StringX(xdg_entry.under("Icon Theme", "Directories")).split(",");
+    auto directory_names = StringX(xdg_entry->under("Icon Theme", "Directories")).split(",");
     for (const auto &name : directory_names) {
-        auto type = xdg_entry.under(name, "Type");
-        auto size = xdg_entry.under(name, "Size");
-        auto maxsize = xdg_entry.under(name, "MaxSize");
-        auto minsize = xdg_entry.under(name, "MinSize");
-        auto threshold = xdg_entry.under(name, "Threshold");
+        auto type = xdg_entry->under(name, "Type");
+        auto size = xdg_entry->under(name, "Size");
+        auto maxsize = xdg_entry->under(name, "MaxSize");
+        auto minsize = xdg_entry->under(name, "MinSize");
+        auto threshold = xdg_entry->under(name, "Threshold");
+        auto context = xdg_entry->under(name, "Context");
 
         auto icon_subdirectory = IconSubdirectory(name, size)
             .type(type)
             .maxSize(maxsize)
             .minSize(minsize)
-            .threshold(threshold);
+            .threshold(threshold)
+            .context(context);
         directories_.push_back(icon_subdirectory);
     }
 }
@@ -0,0 +1,149 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "category_atoms.h"
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace amm {
+
+static std::vector<size_t> atomsOf(const CategorySet &categories)
+{
+    std::vector<size_t> atoms;
+    categories.eachAtom([&atoms](size_t atom) { atoms.push_back(atom); });
+    return atoms;
+}
+
+SCENARIO("CategorySet", "[categoryatoms]") {
+    GIVEN("An empty category set") {
+        CategorySet categories;
+
+        WHEN("created") {
+            THEN("it is empty") {
+                CHECK(categories.empty());
+                CHECK_FALSE(categories.contains(3));
+                CHECK(atomsOf(categories).empty());
+            }
+        }
+
+        WHEN("atoms are inserted") {
+            categories.insert(130);
+            categories.insert(3);
+            categories.insert(130);
+
+            THEN("it contains them") {
+                CHECK_FALSE(categories.empty());
+                CHECK(categories.contains(3));
+                CHECK(categories.contains(130));
+                CHECK_FALSE(categories.contains(4));
+            }
+
+            THEN("they are visited once each, in increasing order, across words") {
+                CHECK(atomsOf(categories) == (std::vector<size_t> { 3, 130 }));
+            }
+
+            THEN("it intersects a set with any of them, across words") {
+                CategorySet other;
+                other.insert(130);
+                CHECK(categories.intersects(other));
+                CHECK(other.intersects(categories));
+            }
+
+            THEN("it doesn't intersect a set with none of them") {
+                CategorySet other;
+                other.insert(4);
+                other.insert(200);
+                CHECK_FALSE(categories.intersects(other));
+            }
+        }
+    }
+}
+
+SCENARIO("CategoryAtoms", "[categoryatoms]") {
+    GIVEN("A table of category atoms") {
+        CategoryAtoms atoms;
+
+        WHEN("looking up registered categories") {
+            THEN("they are numbered in the fixed table") {
+                size_t audio_video;
+                REQUIRE(atoms.find("AudioVideo", &audio_video));
+                CHECK(audio_video < CategoryAtoms::registeredCount());
+                CHECK(atoms.name(audio_video) == "AudioVideo");
+                CHECK(atoms.atom("AudioVideo") == audio_video);
+            }
+
+            THEN("names are matched exactly") {
+                size_t atom;
+                CHECK_FALSE(atoms.find("audiovideo", &atom));
+            }
+        }
+
+        WHEN("interning custom categories") {
+            auto first = atoms.atom("X-Puppy-Setup");
+            auto second = atoms.atom("X-Puppy-Network");
+
+            THEN("they are numbered after the registered ones, in order") {
+                CHECK(first == CategoryAtoms::registeredCount());
+                CHECK(second == CategoryAtoms::registeredCount() + 1);
+                CHECK(atoms.atom("X-Puppy-Setup") == first);
+                CHECK(atoms.name(second) == "X-Puppy-Network");
+            }
+
+            THEN("they are found by exact name only") {
+                size_t atom;
+                CHECK_FALSE(atoms.find("X-Puppy", &atom));
+                CHECK_FALSE(atoms.find("X-Puppy-Setups", &atom));
+            }
+        }
+
+        WHEN("looking up categories in place") {
+            auto custom = atoms.atom("X-Puppy-Setup");
+            std::string text = "Network;X-Puppy-Setup;Net";
+            const char *begin = text.data();
+
+            THEN("registered and custom categories are found within the text") {
+                size_t atom;
+                REQUIRE(atoms.find(LineView(begin, begin + 7), &atom));
+                CHECK(atoms.name(atom) == "Network");
+                REQUIRE(atoms.find(LineView(begin + 8, begin + 21), &atom));
+                CHECK(atom == custom);
+            }
+
+            THEN("a prefix of a category isn't found") {
+                size_t atom;
+                CHECK_FALSE(atoms.find(LineView(begin + 22, begin + 25), &atom));
+                CHECK_FALSE(atoms.find(LineView(begin + 8, begin + 15), &atom));
+            }
+        }
+
+        WHEN("interning a set of categories") {
+            auto categories = atoms.internAll({ "X-Puppy-Setup", "Network", "X-Puppy-Setup" });
+
+            THEN("it holds the atom of each category") {
+                size_t network;
+                REQUIRE(atoms.find("Network", &network));
+                CHECK(atomsOf(categories) == (std::vector<size_t> { network, CategoryAtoms::registeredCount() }));
+            }
+        }
+    }
+}
+
+} // namespace amm
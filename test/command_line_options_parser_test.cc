@@ -84,6 +84,18 @@ SCENARIO("Command-line arguments default parse", "[commandlineoptions]") {
             THEN("its language is the supplied one") {
                 CHECK(options.language == language);
             }
+
+            THEN("it runs a single job") {
+                CHECK(options.jobs == 1);
+            }
+
+            THEN("its watch flag is off") {
+                CHECK_FALSE(options.is_watch);
+            }
+
+            THEN("it doesn't write a trace") {
+                CHECK(options.trace_file_name == "");
+            }
         }
     }
 }
@@ -238,6 +250,42 @@ SCENARIO("Command-line arguments parse with options", "[commandlineoptions]") {
                 CHECK(options.language == "bn");
             }
         }
+
+        WHEN("parsing --jobs [COUNT]") {
+            char* argv[] = {strdup("amm"), strdup("--jobs"), strdup("4"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("its jobs is set to the given value") {
+                CHECK(options.jobs == 4);
+            }
+        }
+
+        WHEN("parsing -j [COUNT]") {
+            char* argv[] = {strdup("amm"), strdup("-j"), strdup("4"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("its jobs is set to the given value") {
+                CHECK(options.jobs == 4);
+            }
+        }
+
+        WHEN("parsing --watch") {
+            char* argv[] = {strdup("amm"), strdup("--watch"), 0};
+            auto options = parser.parse(2, argv);
+
+            THEN("its watch flag is on") {
+                CHECK(options.is_watch);
+            }
+        }
+
+        WHEN("parsing --trace") {
+            char* argv[] = {strdup("amm"), strdup("--trace"), strdup("amm.trace.json"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("its trace file name is set to the given value") {
+                CHECK(options.trace_file_name == "amm.trace.json");
+            }
+        }
     }
 }
 
@@ -257,6 +305,42 @@ SCENARIO("Command-line arguments parse failure", "[commandlineoptions]") {
             }
         }
 
+        WHEN("parsing a job count that isn't positive") {
+            char *argv[] = {strdup("amm"), strdup("--jobs"), strdup("0"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("the parsing fails") {
+                CHECK_FALSE(options.is_parsed);
+            }
+        }
+
+        WHEN("parsing a job count with trailing characters") {
+            char *argv[] = {strdup("amm"), strdup("--jobs"), strdup("4x"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("the parsing fails") {
+                CHECK_FALSE(options.is_parsed);
+            }
+        }
+
+        WHEN("parsing a job count that isn't a number") {
+            char *argv[] = {strdup("amm"), strdup("-j"), strdup("abc"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("the parsing fails") {
+                CHECK_FALSE(options.is_parsed);
+            }
+        }
+
+        WHEN("parsing a job count that is too large") {
+            char *argv[] = {strdup("amm"), strdup("--jobs"), strdup("99999999999999999999"), 0};
+            auto options = parser.parse(3, argv);
+
+            THEN("the parsing fails") {
+                CHECK_FALSE(options.is_parsed);
+            }
+        }
+
         WHEN("parsing a missing mandatory option") {
             char *argv[] = {strdup("amm"), strdup("-c"), 0};
             auto options = parser.parse(2, argv);
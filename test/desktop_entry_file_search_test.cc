@@ -18,6 +18,8 @@
 
 #include "desktop_entry_file_search.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -87,6 +89,34 @@ SCENARIO("DesktopEntryFileSearch custom directories", "[filesearch]") {
             }
         }
     }
+
+    GIVEN("A file search service with a directory that has a symbolic link to a directory") {
+        auto link_directory_name = std::string { "test/fixtures/linked" };
+        auto link_name = link_directory_name + "/nested";
+        unlink(link_name.c_str());
+        rmdir(link_directory_name.c_str());
+        mkdir(link_directory_name.c_str(), 0755);
+        REQUIRE(symlink("../applications/nested", link_name.c_str()) == 0);
+
+        auto searcher = DesktopEntryFileSearch();
+        searcher.registerDirectories({ link_directory_name });
+
+        WHEN("resolved") {
+            searcher.resolve();
+
+            THEN("it follows the link") {
+                auto file_names = searcher.desktopEntryFileNames();
+                std::sort(file_names.begin(), file_names.end());
+                CHECK(file_names == (std::vector<std::string> {
+                    "test/fixtures/linked/nested/deepnested/whaawmp.desktop",
+                    "test/fixtures/linked/nested/xfburn.desktop",
+                }));
+            }
+        }
+
+        unlink(link_name.c_str());
+        rmdir(link_directory_name.c_str());
+    }
 }
 
 SCENARIO("DesktopEntryFileSearch default directories", "[filesearch]") {
@@ -0,0 +1,144 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "desktop_entry_file_watch.h"
+
+#include <unistd.h>
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "filex.h"
+#include "directoryx.h"
+
+namespace amm {
+
+static void ignoreSignal(int) { }
+
+SCENARIO("DesktopEntryFileWatch", "[desktopentryfilewatch]") {
+    auto directory_name = std::string { "test/fixtures/watched" };
+    auto file_name = directory_name + "/editor.desktop";
+    auto other_file_name = directory_name + "/notes.txt";
+    auto subdirectory_name = directory_name + "/nested";
+    remove(file_name.c_str());
+    remove(other_file_name.c_str());
+    rmdir(subdirectory_name.c_str());
+    DirectoryX(directory_name).create();
+
+    GIVEN("A watch on a directory") {
+        DesktopEntryFileWatch file_watch;
+        file_watch.registerDirectories({ directory_name });
+        std::vector<std::string> file_names;
+        auto is_rescan_needed = false;
+
+        THEN("it is valid") {
+            CHECK(file_watch.isValid());
+        }
+
+        THEN("it watches the directory") {
+            CHECK(file_watch.watchedDirectoryNames() == (std::vector<std::string> { directory_name + "/" }));
+        }
+
+        WHEN("a desktop file is written") {
+            FileX(other_file_name).writeLines({ "notes" });
+            FileX(file_name).writeLines({ "[Desktop Entry]", "Name=Editor" });
+
+            THEN("only the desktop file is reported") {
+                CHECK(file_watch.wait(&file_names, &is_rescan_needed, 10));
+                CHECK(file_names == (std::vector<std::string> { file_name }));
+                CHECK_FALSE(is_rescan_needed);
+            }
+        }
+
+        WHEN("a desktop file is removed") {
+            FileX(file_name).writeLines({ "[Desktop Entry]", "Name=Editor" });
+            file_watch.wait(&file_names, &is_rescan_needed, 10);
+            remove(file_name.c_str());
+
+            THEN("it is reported") {
+                CHECK(file_watch.wait(&file_names, &is_rescan_needed, 10));
+                CHECK(file_names == (std::vector<std::string> { file_name }));
+            }
+        }
+
+        WHEN("a directory is created") {
+            DirectoryX(subdirectory_name).create();
+
+            THEN("a rescan is needed") {
+                CHECK(file_watch.wait(&file_names, &is_rescan_needed, 10));
+                CHECK(is_rescan_needed);
+            }
+
+            THEN("the new directory is watched") {
+                file_watch.wait(&file_names, &is_rescan_needed, 10);
+                CHECK(file_watch.watchedDirectoryNames() == (std::vector<std::string> { directory_name + "/", subdirectory_name + "/" }));
+            }
+        }
+    }
+
+    GIVEN("A watch that unblocks a signal only while waiting") {
+        DesktopEntryFileWatch file_watch;
+        file_watch.registerDirectories({ directory_name });
+        std::vector<std::string> file_names;
+        auto is_rescan_needed = false;
+
+        struct sigaction action;
+        action.sa_handler = ignoreSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0;
+        struct sigaction previous_action;
+        sigaction(SIGUSR1, &action, &previous_action);
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGUSR1);
+        sigset_t previous_mask;
+        sigprocmask(SIG_BLOCK, &signals, &previous_mask);
+        auto wait_mask = previous_mask;
+        sigdelset(&wait_mask, SIGUSR1);
+        file_watch.registerWaitSignalMask(wait_mask);
+
+        WHEN("the signal arrives before waiting") {
+            raise(SIGUSR1);
+
+            THEN("waiting is interrupted at once") {
+                CHECK_FALSE(file_watch.wait(&file_names, &is_rescan_needed, 10));
+            }
+        }
+
+        sigprocmask(SIG_SETMASK, &previous_mask, nullptr);
+        sigaction(SIGUSR1, &previous_action, nullptr);
+    }
+
+    GIVEN("A watch on a missing directory") {
+        DesktopEntryFileWatch file_watch;
+        file_watch.registerDirectories({ "test/does-not-exist-fixtures" });
+
+        THEN("nothing is watched") {
+            CHECK(file_watch.watchedDirectoryNames().empty());
+        }
+    }
+
+    remove(file_name.c_str());
+    remove(other_file_name.c_str());
+    rmdir(subdirectory_name.c_str());
+    rmdir(directory_name.c_str());
+}
+
+} // namespace amm
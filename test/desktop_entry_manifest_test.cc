@@ -0,0 +1,125 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "desktop_entry_manifest.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "filex.h"
+#include "xdg/desktop_entry.h"
+
+namespace amm {
+
+static xdg::DesktopEntry manifestEntry()
+{
+    return xdg::DesktopEntry("Media\tPlayer", "vlc", "vlc %U", { "Player", "", "AudioVideo" }, "Play back\\stream", false);
+}
+
+SCENARIO("DesktopEntryManifest", "[desktopentrymanifest]") {
+    auto file_name = std::string { "test/fixtures/manifest" };
+    auto desktop_file_name = std::string { "/usr/share/applications/vlc.desktop" };
+    remove(file_name.c_str());
+
+    GIVEN("A desktop entry manifest") {
+        xdg::DesktopEntry entry;
+
+        WHEN("a desktop file isn't recorded") {
+            DesktopEntryManifest manifest(file_name, "bn");
+
+            THEN("it isn't found") {
+                CHECK_FALSE(manifest.find(desktop_file_name, 100, 20, &entry));
+            }
+        }
+
+        WHEN("a desktop file is recorded") {
+            DesktopEntryManifest manifest(file_name, "bn");
+            manifest.add(desktop_file_name, 100, 20, manifestEntry());
+
+            THEN("it is found while its modification time and size are unchanged") {
+                CHECK(manifest.find(desktop_file_name, 100, 20, &entry));
+                CHECK(entry.name() == "Media\tPlayer");
+            }
+
+            THEN("it isn't found once modified") {
+                CHECK_FALSE(manifest.find(desktop_file_name, 101, 20, &entry));
+                CHECK_FALSE(manifest.find(desktop_file_name, 100, 21, &entry));
+            }
+
+            THEN("it isn't found once removed") {
+                manifest.remove(desktop_file_name);
+                CHECK_FALSE(manifest.find(desktop_file_name, 100, 20, &entry));
+            }
+
+            THEN("it isn't found once it isn't retained") {
+                manifest.retainOnly({ "/usr/share/applications/mousepad.desktop" });
+                CHECK(manifest.size() == 0);
+            }
+        }
+
+        WHEN("a recorded desktop file is saved") {
+            {
+                DesktopEntryManifest manifest(file_name, "bn");
+                manifest.add(desktop_file_name, 100, 20, manifestEntry());
+            }
+
+            THEN("a later manifest for the same language has all its fields") {
+                DesktopEntryManifest manifest(file_name, "bn");
+                REQUIRE(manifest.find(desktop_file_name, 100, 20, &entry));
+                CHECK(entry.name() == "Media\tPlayer");
+                CHECK(entry.icon() == "vlc");
+                CHECK(entry.executable() == "vlc %U");
+                CHECK(entry.comment() == "Play back\\stream");
+                CHECK(entry.categories() == (std::vector<std::string> { "", "AudioVideo", "Player" }));
+                CHECK_FALSE(entry.display());
+            }
+
+            THEN("a later manifest for another language discards it") {
+                DesktopEntryManifest manifest(file_name, "sr");
+                CHECK(manifest.size() == 0);
+            }
+        }
+
+        WHEN("a manifest file was written before parser revisions were recorded") {
+            FileX(file_name).writeLines({
+                "amm-manifest-1 bn",
+                desktop_file_name + "\t100\t20\tVLC\tvlc\tvlc %U\t\tAudioVideo;\t1",
+            });
+
+            THEN("it is discarded") {
+                DesktopEntryManifest manifest(file_name, "bn");
+                CHECK(manifest.size() == 0);
+            }
+        }
+
+        WHEN("the manifest file can't be written") {
+            DesktopEntryManifest manifest("test/does-not-exist-fixtures/manifest", "bn");
+            manifest.add(desktop_file_name, 100, 20, manifestEntry());
+
+            THEN("saving fails") {
+                CHECK_FALSE(manifest.save());
+            }
+        }
+    }
+
+    remove(file_name.c_str());
+}
+
+} // namespace amm
@@ -18,6 +18,7 @@
 
 #include "directoryx.h"
 
+#include <unistd.h>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -85,6 +86,29 @@ SCENARIO("DirectoryX", "[directoryx]") {
             }
         }
 
+        WHEN("created") {
+            auto directory = DirectoryX("test/fixtures/new-directory");
+            rmdir("test/fixtures/new-directory");
+
+            THEN("it becomes valid") {
+                CHECK(directory.create());
+                CHECK(directory.isValid());
+            }
+
+            THEN("creating it again succeeds") {
+                CHECK(directory.create());
+                CHECK(directory.create());
+            }
+
+            rmdir("test/fixtures/new-directory");
+        }
+
+        WHEN("created under a missing parent") {
+            THEN("it fails") {
+                CHECK_FALSE(DirectoryX("test/does-not-exist-fixtures/new-directory").create());
+            }
+        }
+
         WHEN("it has files under itself") {
             auto directory = DirectoryX("test/fixtures/applications");
             auto entries = directory.allEntries();
@@ -39,6 +39,18 @@ SCENARIO("FileX", "[filex]") {
                 CHECK_FALSE(filex.existsAsDirectory());
             }
 
+            THEN("it has a modification time") {
+                CHECK(filex.modificationTime() > 0);
+            }
+
+            THEN("it has a status with a finer modification time and a size") {
+                long long modification_time = 0;
+                long long size = 0;
+                CHECK(filex.status(&modification_time, &size));
+                CHECK(modification_time / 1000000000LL == filex.modificationTime());
+                CHECK(size == 274);
+            }
+
             THEN("it succeeds in reading its contents") {
                 auto lines = std::vector<std::string> {};
                 CHECK(filex.readLines(&lines));
@@ -62,6 +74,13 @@ SCENARIO("FileX", "[filex]") {
                 }));
             }
 
+            THEN("it reads the whole file at once") {
+                auto content = std::string { "older content" };
+                CHECK(filex.readAll(&content));
+                CHECK(content.size() == 274);
+                CHECK(content.compare(0, 28, "[Desktop Entry]\nVersion=1.0\n") == 0);
+            }
+
             THEN("it over-writes the older content") {
                 auto lines = std::vector<std::string> {};
                 filex.readLines(&lines);
@@ -74,6 +93,10 @@ SCENARIO("FileX", "[filex]") {
                 CHECK_FALSE(filex.writeLines(lines));
             }
 
+            THEN("it doesn't write content to the file") {
+                CHECK_FALSE(filex.writeAll("first\nsecond\n"));
+            }
+
             THEN("it can move the file to an existing directory") {
                 auto file_name = std::string { "test/fixtures/new-file" };
                 auto renamed_file_name = std::string { "test/fixtures/renamed-file" };
@@ -126,6 +149,11 @@ SCENARIO("FileX", "[filex]") {
             THEN("it is a directory") {
                 CHECK(dirx.existsAsDirectory());
             }
+
+            THEN("it fails to read its contents at once") {
+                auto content = std::string {};
+                CHECK_FALSE(dirx.readAll(&content));
+            }
         }
 
         WHEN("pointing to a file that doesn't exist") {
@@ -142,11 +170,27 @@ SCENARIO("FileX", "[filex]") {
                 CHECK_FALSE(filex.existsAsDirectory());
             }
 
+            THEN("it doesn't have a modification time") {
+                CHECK(filex.modificationTime() == 0);
+            }
+
+            THEN("it doesn't have a status") {
+                long long modification_time = 0;
+                long long size = 0;
+                CHECK_FALSE(filex.status(&modification_time, &size));
+            }
+
             THEN("it fails to read its contents") {
                 auto lines = std::vector<std::string> {};
                 CHECK_FALSE(filex.readLines(&lines));
             }
 
+            THEN("it fails to read its contents at once") {
+                auto content = std::string { "existing content" };
+                CHECK_FALSE(filex.readAll(&content));
+                CHECK(content == "existing content");
+            }
+
             THEN("its lines are empty") {
                 auto lines = std::vector<std::string> {};
                 filex.readLines(&lines);
@@ -169,6 +213,19 @@ SCENARIO("FileX", "[filex]") {
                 CHECK(lines == (std::vector<std::string> { "first", "second" } ));
                 remove(file_name.c_str());
             }
+
+            THEN("it writes the whole content to the file at once") {
+                CHECK(filex.writeAll("first\nsecond\n"));
+
+                auto content = std::string {};
+                CHECK(FileX(file_name).readAll(&content));
+                CHECK(content == "first\nsecond\n");
+                remove(file_name.c_str());
+            }
+
+            THEN("it can't write the content under a non-existing directory") {
+                CHECK_FALSE(FileX("test/does-not-exist-fixtures/new-file").writeAll("first\n"));
+            }
         }
     }
 }
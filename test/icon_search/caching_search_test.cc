@@ -18,8 +18,13 @@
 
 #include "icon_search/caching_search.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 #include "../catch.hpp"
 #include "icon_search/icon_search_interface.h"
 
@@ -36,11 +41,62 @@ private:
     std::string extension_;
 };
 
+class SlowCountingSearch : public IconSearchInterface
+{
+public:
+    explicit SlowCountingSearch(std::atomic<int> *count) : count_(count) { }
+    std::string resolvedName(const std::string &icon_name) const
+    {
+        ++*count_;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return icon_name + ".png";
+    }
+private:
+    std::atomic<int> *count_;
+};
+
+class BatchRecordingSearch : public IconSearchInterface
+{
+public:
+    explicit BatchRecordingSearch(std::vector<std::vector<std::string>> *batches) : batches_(batches) { }
+    std::string resolvedName(const std::string &icon_name) const { return icon_name + ".png"; }
+    std::vector<std::string> resolveAll(const std::vector<std::string> &icon_names) const
+    {
+        batches_->push_back(icon_names);
+        return IconSearchInterface::resolveAll(icon_names);
+    }
+private:
+    std::vector<std::vector<std::string>> *batches_;
+};
+
+// The first search waits until it is released and then fails; later searches succeed
+class FailingOnceSearch : public IconSearchInterface
+{
+public:
+    FailingOnceSearch(std::atomic<bool> *is_started, std::atomic<bool> *is_released) :
+        is_started_(is_started), is_released_(is_released), has_failed_(false) { }
+    std::string resolvedName(const std::string &icon_name) const
+    {
+        if (has_failed_.exchange(true)) {
+            return icon_name + ".png";
+        }
+        *is_started_ = true;
+        while (!*is_released_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        throw std::runtime_error("search failed");
+    }
+private:
+    std::atomic<bool> *is_started_;
+    std::atomic<bool> *is_released_;
+    mutable std::atomic<bool> has_failed_;
+};
+
 SCENARIO("icon_search::CachingSearch", "[cachingsearch]") {
     auto actual_searcher = new TestSearch;
 
     GIVEN("An icon search that caches results") {
-        auto caching_searcher = CachingSearch(actual_searcher);
+        CachingSearch caching_searcher(actual_searcher);
 
         WHEN("retrieving an unsearched item") {
             THEN("the item is absent from the cache") {
@@ -69,5 +125,116 @@ SCENARIO("icon_search::CachingSearch", "[cachingsearch]") {
     }
 }
 
+SCENARIO("icon_search::CachingSearch on several threads", "[cachingsearch]") {
+    GIVEN("An icon search that caches results over a slow search") {
+        std::atomic<int> searches(0);
+        CachingSearch caching_searcher(new SlowCountingSearch(&searches));
+        std::vector<std::string> results(8);
+
+        WHEN("several threads ask for the same unsearched item at once") {
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < results.size(); ++i) {
+                threads.push_back(std::thread([&caching_searcher, &results, i] { results[i] = caching_searcher.resolvedName("vlc"); }));
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+
+            THEN("the underlying implementation is searched once") {
+                CHECK(searches == 1);
+            }
+
+            THEN("every thread gets the result") {
+                CHECK(results == std::vector<std::string>(8, "vlc.png"));
+                CHECK(caching_searcher.isCached("vlc"));
+            }
+        }
+
+        WHEN("several threads ask for different items at once") {
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < results.size(); ++i) {
+                threads.push_back(std::thread([&caching_searcher, &results, i] { results[i] = caching_searcher.resolvedName("icon-" + std::to_string(i)); }));
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+
+            THEN("each item is searched once") {
+                CHECK(searches == 8);
+                CHECK(results[3] == "icon-3.png");
+            }
+        }
+    }
+}
+
+SCENARIO("icon_search::CachingSearch resolving several items", "[cachingsearch]") {
+    GIVEN("An icon search that caches results over a search that fails once") {
+        std::atomic<bool> is_started(false);
+        std::atomic<bool> is_released(false);
+        CachingSearch caching_searcher(new FailingOnceSearch(&is_started, &is_released));
+
+        WHEN("a thread waits for an item whose search fails") {
+            auto has_thrown = false;
+            std::thread failing([&caching_searcher, &has_thrown] {
+                try {
+                    caching_searcher.resolvedName("vlc");
+                } catch (const std::runtime_error &) {
+                    has_thrown = true;
+                }
+            });
+            while (!is_started) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            std::string waited_name;
+            std::thread waiting([&caching_searcher, &waited_name] { waited_name = caching_searcher.resolvedName("vlc"); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            is_released = true;
+            failing.join();
+            waiting.join();
+
+            THEN("the failure reaches the thread that searched") {
+                CHECK(has_thrown);
+            }
+
+            THEN("the waiting thread searches again instead of hanging") {
+                CHECK(waited_name == "vlc.png");
+                CHECK(caching_searcher.isCached("vlc"));
+            }
+        }
+    }
+
+    GIVEN("An icon search that caches results with an item searched earlier") {
+        std::vector<std::vector<std::string>> batches;
+        CachingSearch caching_searcher(new BatchRecordingSearch(&batches));
+        caching_searcher.resolvedName("vlc");
+
+        WHEN("resolving several items together") {
+            auto resolved_names = caching_searcher.resolveAll({ "firefox", "vlc", "gimp", "firefox" });
+
+            THEN("the items are resolved in order") {
+                CHECK(resolved_names == (std::vector<std::string> { "firefox.png", "vlc.png", "gimp.png", "firefox.png" }));
+            }
+
+            THEN("the uncached items are searched together, once each") {
+                REQUIRE(batches.size() == 1);
+                CHECK(batches[0] == (std::vector<std::string> { "firefox", "gimp" }));
+            }
+
+            THEN("the items are cached") {
+                CHECK(caching_searcher.isCached("firefox"));
+                CHECK(caching_searcher.isCached("gimp"));
+            }
+        }
+
+        WHEN("resolving only cached items together") {
+            caching_searcher.resolveAll({ "vlc" });
+
+            THEN("the underlying implementation isn't searched") {
+                CHECK(batches.empty());
+            }
+        }
+    }
+}
+
 } // namespace icon_search
 } // namespace amm
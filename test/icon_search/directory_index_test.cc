@@ -0,0 +1,93 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/directory_index.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "../catch.hpp"
+
+namespace amm {
+namespace icon_search {
+
+SCENARIO("icon_search::DirectoryIndex", "[directoryindex]") {
+    GIVEN("A directory index with registered extensions") {
+        DirectoryIndex directory_index({ ".desktop", ".vlc" });
+        auto directory_name = std::string { "test/fixtures/applications" };
+
+        WHEN("a directory hasn't been searched") {
+            THEN("it isn't indexed") {
+                CHECK_FALSE(directory_index.isIndexed(directory_name));
+            }
+        }
+
+        WHEN("searching for a name present with a registered extension") {
+            auto file_names = directory_index.fileNames(directory_name, "vlc");
+
+            THEN("it has the file name with the extension") {
+                CHECK(file_names == (std::vector<std::string> { "test/fixtures/applications/vlc.desktop" }));
+            }
+
+            THEN("the directory is indexed") {
+                CHECK(directory_index.isIndexed(directory_name));
+            }
+        }
+
+        WHEN("searching for a name that already has a registered extension") {
+            THEN("the extension isn't repeated") {
+                CHECK(directory_index.fileNames(directory_name, "vlc.desktop") == (std::vector<std::string> { "test/fixtures/applications/vlc.desktop" }));
+            }
+        }
+
+        WHEN("searching for a name present with another registered extension") {
+            THEN("it has the file name with that extension") {
+                CHECK(directory_index.fileNames(directory_name, "desktop") == (std::vector<std::string> { "test/fixtures/applications/desktop.vlc" }));
+            }
+        }
+
+        WHEN("searching for a name that isn't present") {
+            THEN("it is empty") {
+                CHECK(directory_index.fileNames(directory_name, "nested").empty());
+            }
+        }
+
+        WHEN("searching for several names together") {
+            std::vector<std::pair<size_t, std::string>> found;
+            directory_index.eachFileName(directory_name, { "nested", "desktop", "vlc" }, [&found](size_t i, const std::string &file_name) {
+                found.push_back(std::make_pair(i, file_name));
+            });
+
+            THEN("each file present is reported with the position of its name") {
+                CHECK(found == (std::vector<std::pair<size_t, std::string>> {
+                    { 1, "test/fixtures/applications/desktop.vlc" },
+                    { 2, "test/fixtures/applications/vlc.desktop" },
+                }));
+            }
+        }
+
+        WHEN("searching in a missing directory") {
+            THEN("it is empty") {
+                CHECK(directory_index.fileNames("test/does-not-exist-fixtures", "vlc").empty());
+            }
+        }
+    }
+}
+
+} // namespace icon_search
+} // namespace amm
@@ -0,0 +1,114 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/icon_theme_cache.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string>
+#include <vector>
+#include "../catch.hpp"
+
+namespace amm {
+namespace icon_search {
+
+static void setModificationTime(const std::string &file_name, time_t seconds)
+{
+    struct timespec times[2];
+    times[0].tv_sec = seconds;
+    times[0].tv_nsec = 0;
+    times[1] = times[0];
+    utimensat(AT_FDCWD, file_name.c_str(), times, 0);
+}
+
+SCENARIO("icon_search::IconThemeCache", "[iconthemecache]") {
+    auto theme_directory_name = std::string { "test/fixtures/icon_theme_cache" };
+    auto cache_file_name = theme_directory_name + "/icon-theme.cache";
+    auto extensions = std::vector<std::string> { ".png", ".svg", ".xpm" };
+
+    GIVEN("An icon theme cache newer than its theme directory") {
+        setModificationTime(cache_file_name, time(nullptr) + 60);
+        IconThemeCache cache(theme_directory_name, extensions);
+
+        THEN("it is valid") {
+            CHECK(cache.isValid());
+        }
+
+        THEN("it knows the sub-directories of the theme") {
+            CHECK(cache.hasSubdirectory("48x48/apps"));
+            CHECK(cache.hasSubdirectory("scalable/apps"));
+            CHECK_FALSE(cache.hasSubdirectory("16x16/apps"));
+        }
+
+        WHEN("looking up an icon in a sub-directory that has it") {
+            THEN("it has the file name with the cached extension") {
+                CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "vlc") == (std::vector<std::string> { "/icons/48x48/apps/vlc.png" }));
+                CHECK(cache.fileNames("/icons/scalable/apps", "scalable/apps", "vlc") == (std::vector<std::string> { "/icons/scalable/apps/vlc.svg" }));
+            }
+
+            THEN("it has file names for every cached extension in registered order") {
+                CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "firefox") == (std::vector<std::string> { "/icons/48x48/apps/firefox.png", "/icons/48x48/apps/firefox.xpm" }));
+            }
+
+            THEN("icons sharing a hash bucket are told apart") {
+                CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "mousepad") == (std::vector<std::string> { "/icons/48x48/apps/mousepad.png" }));
+                CHECK(cache.fileNames("/icons/48x48/categories", "48x48/categories", "applications-multimedia") == (std::vector<std::string> { "/icons/48x48/categories/applications-multimedia.png" }));
+            }
+        }
+
+        WHEN("looking up an icon name that has an extension") {
+            THEN("the extension isn't repeated") {
+                CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "firefox.xpm") == (std::vector<std::string> { "/icons/48x48/apps/firefox.xpm" }));
+            }
+        }
+
+        WHEN("looking up an icon in a sub-directory that doesn't have it") {
+            THEN("it is empty") {
+                CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "gimp").empty());
+                CHECK(cache.fileNames("/icons/16x16/apps", "16x16/apps", "vlc").empty());
+            }
+        }
+
+        WHEN("looking up an icon that isn't cached") {
+            THEN("it is empty") {
+                CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "missing").empty());
+            }
+        }
+    }
+
+    GIVEN("An icon theme cache older than its theme directory") {
+        setModificationTime(cache_file_name, 1);
+        IconThemeCache cache(theme_directory_name, extensions);
+
+        THEN("it isn't valid") {
+            CHECK_FALSE(cache.isValid());
+            CHECK(cache.fileNames("/icons/48x48/apps", "48x48/apps", "vlc").empty());
+        }
+    }
+
+    GIVEN("A theme directory without an icon theme cache") {
+        IconThemeCache cache("test/fixtures/applications", extensions);
+
+        THEN("it isn't valid") {
+            CHECK_FALSE(cache.isValid());
+        }
+    }
+}
+
+} // namespace icon_search
+} // namespace amm
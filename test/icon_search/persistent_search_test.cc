@@ -0,0 +1,123 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_search/persistent_search.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../catch.hpp"
+#include "icon_search/icon_search_interface.h"
+
+namespace amm {
+namespace icon_search {
+
+class CountingSearch : public IconSearchInterface
+{
+public:
+    explicit CountingSearch(int *count) : count_(count) { }
+    std::string resolvedName(const std::string &icon_name) const { ++*count_; return "/icons/" + icon_name + ".png"; }
+private:
+    int *count_;
+};
+
+SCENARIO("icon_search::PersistentSearch", "[persistentsearch]") {
+    auto file_name = std::string { "test/fixtures/icon-cache" };
+    remove(file_name.c_str());
+    auto searches = 0;
+
+    GIVEN("An icon search that persists results") {
+        WHEN("retrieving an unsearched item") {
+            PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "key");
+
+            THEN("the item is absent from the cache") {
+                CHECK_FALSE(persistent_searcher.isCached("vlc"));
+            }
+
+            THEN("the underlying implementation is searched") {
+                CHECK(persistent_searcher.resolvedName("vlc") == "/icons/vlc.png");
+                CHECK(searches == 1);
+            }
+        }
+
+        WHEN("a searched item is saved") {
+            {
+                PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "key");
+                persistent_searcher.resolvedName("vlc");
+            }
+
+            THEN("a later search with the same key reuses it without searching") {
+                PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "key");
+                CHECK(persistent_searcher.isCached("vlc"));
+                CHECK(persistent_searcher.resolvedName("vlc") == "/icons/vlc.png");
+                CHECK(searches == 1);
+            }
+
+            THEN("a later search with a different key discards it") {
+                PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "changed-key");
+                CHECK_FALSE(persistent_searcher.isCached("vlc"));
+                CHECK(persistent_searcher.resolvedName("vlc") == "/icons/vlc.png");
+                CHECK(searches == 2);
+            }
+        }
+
+        WHEN("resolving several items together") {
+            PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "key");
+            persistent_searcher.resolvedName("vlc");
+            auto resolved_names = persistent_searcher.resolveAll({ "gimp", "vlc" });
+
+            THEN("the items are resolved in order") {
+                CHECK(resolved_names == (std::vector<std::string> { "/icons/gimp.png", "/icons/vlc.png" }));
+            }
+
+            THEN("only the items missing from the cache are searched") {
+                CHECK(searches == 2);
+                CHECK(persistent_searcher.isCached("gimp"));
+            }
+        }
+
+        WHEN("a searched item with tabs and newlines in its name is saved") {
+            {
+                PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "key");
+                persistent_searcher.resolvedName("vlc\tplayer\n\\");
+            }
+
+            THEN("a later search reads it back unchanged") {
+                PersistentSearch persistent_searcher(new CountingSearch(&searches), file_name, "key");
+                CHECK(persistent_searcher.isCached("vlc\tplayer\n\\"));
+                CHECK(persistent_searcher.resolvedName("vlc\tplayer\n\\") == "/icons/vlc\tplayer\n\\.png");
+                CHECK(searches == 1);
+            }
+        }
+
+        WHEN("the cache file can't be written") {
+            PersistentSearch persistent_searcher(new CountingSearch(&searches), "test/does-not-exist-fixtures/icon-cache", "key");
+            persistent_searcher.resolvedName("vlc");
+
+            THEN("saving fails") {
+                CHECK_FALSE(persistent_searcher.save());
+            }
+        }
+    }
+
+    remove(file_name.c_str());
+}
+
+} // namespace icon_search
+} // namespace amm
@@ -0,0 +1,95 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "icon_theme_registry.h"
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "xdg/icon_theme.h"
+
+namespace amm {
+
+static std::vector<std::string> namesOf(const std::vector<xdg::IconTheme> &icon_themes)
+{
+    std::vector<std::string> names;
+    for (const auto &icon_theme : icon_themes) {
+        names.push_back(icon_theme.internalName());
+    }
+    return names;
+}
+
+SCENARIO("IconThemeRegistry", "[iconthemeregistry]") {
+    GIVEN("A registry of the themes installed under a search path") {
+        IconThemeRegistry registry({ "test/fixtures/icon_themes", "test/does-not-exist-fixtures" });
+
+        WHEN("indexed") {
+            THEN("it has every directory with an index.theme") {
+                CHECK(registry.size() == 6);
+                CHECK_FALSE(registry.isInstalled("not-a-theme"));
+            }
+
+            THEN("themes are known by both their name and their directory name") {
+                CHECK(registry.isInstalled("Papirus"));
+                CHECK(registry.isInstalled("papirus"));
+            }
+        }
+
+        WHEN("looking up a theme that inherits along several paths") {
+            THEN("it has all of its ancestors depth-first, each once") {
+                CHECK(namesOf(registry.themeWithAncestors("Papirus")) == (std::vector<std::string> { "papirus", "adwaita", "hicolor", "breeze" }));
+            }
+
+            THEN("it is the same when looked up by directory name, or again") {
+                CHECK(namesOf(registry.themeWithAncestors("papirus")) == (std::vector<std::string> { "papirus", "adwaita", "hicolor", "breeze" }));
+                CHECK(namesOf(registry.themeWithAncestors("papirus")) == (std::vector<std::string> { "papirus", "adwaita", "hicolor", "breeze" }));
+            }
+        }
+
+        WHEN("looking up themes that inherit from each other") {
+            THEN("the cycle is followed once and ends with hicolor") {
+                CHECK(namesOf(registry.themeWithAncestors("loop-a")) == (std::vector<std::string> { "loop-a", "loop-b", "hicolor" }));
+            }
+        }
+
+        WHEN("looking up hicolor") {
+            THEN("it is on its own") {
+                CHECK(namesOf(registry.themeWithAncestors("hicolor")) == (std::vector<std::string> { "hicolor" }));
+            }
+        }
+
+        WHEN("looking up a theme that isn't installed") {
+            THEN("it falls back to hicolor") {
+                CHECK(namesOf(registry.themeWithAncestors("Faenza")) == (std::vector<std::string> { "hicolor" }));
+            }
+        }
+    }
+
+    GIVEN("A registry with no search paths") {
+        IconThemeRegistry registry({});
+
+        WHEN("looking up a theme") {
+            THEN("it is empty") {
+                CHECK(registry.themeWithAncestors("hicolor").empty());
+            }
+        }
+    }
+}
+
+} // namespace amm
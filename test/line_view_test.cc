@@ -0,0 +1,106 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "line_view.h"
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace amm {
+
+std::vector<std::string> scannedLines(const std::string &content)
+{
+    std::vector<std::string> lines;
+    LineScanner scanner(content);
+    LineView line;
+    while (scanner.next(&line)) {
+        lines.push_back(line.str());
+    }
+    return lines;
+}
+
+SCENARIO("LineView", "[lineview]") {
+    GIVEN("A line view") {
+        auto content = std::string { " \tName = VLC\r\n" };
+        auto line = LineView(content.data(), content.data() + content.size());
+
+        WHEN("trimmed") {
+            auto trimmed = line.trim();
+
+            THEN("surrounding whitespaces are excluded") {
+                CHECK(trimmed.str() == "Name = VLC");
+            }
+
+            THEN("it can be compared without copying") {
+                CHECK(trimmed.is("Name = VLC", 10));
+                CHECK_FALSE(trimmed.is("Name", 4));
+                CHECK(trimmed.startsWith("Name", 4));
+                CHECK_FALSE(trimmed.startsWith("Icon", 4));
+            }
+
+            THEN("characters can be found within it") {
+                CHECK(trimmed.find('=') == content.data() + 7);
+                CHECK(trimmed.find('#') == nullptr);
+            }
+        }
+
+        WHEN("it holds an escaped field") {
+            auto escaped = std::string { "/icons/a\\tb\\nc\\\\d.png" };
+            auto field = LineView(escaped.data(), escaped.data() + escaped.size());
+
+            THEN("unescaping restores tabs, newlines and backslashes") {
+                CHECK(field.unescapeField() == "/icons/a\tb\nc\\d.png");
+            }
+        }
+
+        WHEN("it only has whitespaces") {
+            auto blank = std::string { " \t \n" };
+            auto blank_line = LineView(blank.data(), blank.data() + blank.size());
+
+            THEN("it is empty when trimmed") {
+                CHECK(blank_line.trim().empty());
+            }
+        }
+    }
+}
+
+SCENARIO("LineScanner", "[lineview]") {
+    GIVEN("A buffer") {
+        WHEN("it has newline terminated lines") {
+            THEN("each line is scanned without the newline") {
+                CHECK(scannedLines("first\n\nthird\n") == (std::vector<std::string> { "first", "", "third" }));
+            }
+        }
+
+        WHEN("its last line isn't terminated") {
+            THEN("the last line is scanned as well") {
+                CHECK(scannedLines("first\nsecond") == (std::vector<std::string> { "first", "second" }));
+            }
+        }
+
+        WHEN("it is empty") {
+            THEN("no lines are scanned") {
+                CHECK(scannedLines("").empty());
+            }
+        }
+    }
+}
+
+} // namespace amm
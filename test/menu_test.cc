@@ -18,11 +18,15 @@
 
 #include "menu.h"
 
+#include <atomic>
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "catch.hpp"
+#include "filex.h"
+#include "trace.h"
 #include "representation/menu_start.h"
 #include "representation/menu_end.h"
 #include "representation/subcategory_start.h"
@@ -70,6 +74,15 @@ public:
     std::string resolvedName(const std::string &name) const { return name + ".always"; }
 };
 
+class CountingIconSearch : public icon_search::IconSearchInterface
+{
+public:
+    explicit CountingIconSearch(std::atomic<int> *count) : count_(count) { }
+    std::string resolvedName(const std::string &name) const { ++*count_; return name + ".counted"; }
+private:
+    std::atomic<int> *count_;
+};
+
 
 SCENARIO("Menu custom categories", "[menu]") {
     GIVEN("A menu") {
@@ -144,6 +157,22 @@ SCENARIO("Menu custom categories", "[menu]") {
             }
         }
 
+        WHEN("loaded with custom categories that accept several of an entry's categories") {
+            auto lines = std::vector<std::string> { "Media:media:AudioVideo:Player:Recorder", "Players:players:Player", "Tools:tools:Archiving" };
+            menu.loadCustomCategories(lines);
+            menu.populate({ kapplicationFixturesDirectory + "vlc.desktop" });
+
+            THEN("the entry is in each accepting subcategory once") {
+                auto subcategories = menu.subcategories();
+
+                REQUIRE(subcategories.size() == 4);
+                CHECK(subcategories[0].desktopEntries().size() == 1);
+                CHECK(subcategories[1].desktopEntries().size() == 1);
+                CHECK_FALSE(subcategories[2].hasEntries());
+                CHECK_FALSE(subcategories[3].hasEntries());
+            }
+        }
+
         WHEN("given a line without a single classification name") {
             auto lines = std::vector<std::string>  { "Games:games:::" };
             menu.loadCustomCategories(lines);
@@ -263,6 +292,172 @@ SCENARIO("Menu sort", "[menu]") {
     }
 }
 
+SCENARIO("Menu populated on multiple jobs", "[menu]") {
+    GIVEN("A menu populated on a single job and a menu populated on multiple jobs") {
+        auto files = std::vector<std::string> {
+            kapplicationFixturesDirectory + "vlc.desktop",
+            kapplicationFixturesDirectory + "suppressed.desktop",
+            kapplicationFixturesDirectory + "nested/xfburn.desktop",
+            kapplicationFixturesDirectory + "missing.desktop",
+            kapplicationFixturesDirectory + "unclassified.desktop",
+            kapplicationFixturesDirectory + "does-not-exist.desktop",
+            kapplicationFixturesDirectory + "mousepad.desktop",
+        };
+
+        auto serial_menu = Menu();
+        serial_menu.populate(files);
+
+        auto parallel_menu = Menu();
+        parallel_menu.registerJobs(4);
+        parallel_menu.populate(files);
+
+        WHEN("transformed to representations") {
+            auto transformer = TestTransformer();
+            auto serial_representations = serial_menu.representations();
+            auto parallel_representations = parallel_menu.representations();
+
+            THEN("they are identical") {
+                REQUIRE(serial_representations.size() == parallel_representations.size());
+                for (size_t i = 0; i < serial_representations.size(); ++i) {
+                    CHECK(serial_representations[i]->visit(transformer) == parallel_representations[i]->visit(transformer));
+                }
+            }
+        }
+
+        WHEN("summarized") {
+            THEN("they are identical") {
+                CHECK(serial_menu.summary().details("long") == parallel_menu.summary().details("long"));
+            }
+        }
+
+        WHEN("transformed to representations with an icon service") {
+            std::atomic<int> serial_searches(0);
+            std::atomic<int> parallel_searches(0);
+            serial_menu.registerIconService(new CountingIconSearch(&serial_searches));
+            parallel_menu.registerIconService(new CountingIconSearch(&parallel_searches));
+            auto transformer = TestTransformer();
+            auto serial_representations = serial_menu.representations();
+            auto parallel_representations = parallel_menu.representations();
+
+            THEN("they are identical") {
+                REQUIRE(serial_representations.size() == parallel_representations.size());
+                for (size_t i = 0; i < serial_representations.size(); ++i) {
+                    CHECK(serial_representations[i]->visit(transformer) == parallel_representations[i]->visit(transformer));
+                }
+            }
+
+            THEN("each icon name is searched once") {
+                CHECK(serial_searches == 7);
+                CHECK(parallel_searches == 7);
+            }
+        }
+    }
+}
+
+SCENARIO("Menu refreshed with changed desktop files", "[menu]") {
+    GIVEN("A populated menu") {
+        auto changed_file_name = std::string { "test/fixtures/changed.desktop" };
+        remove(changed_file_name.c_str());
+        auto files = std::vector<std::string> {
+            kapplicationFixturesDirectory + "vlc.desktop",
+            kapplicationFixturesDirectory + "mousepad.desktop",
+        };
+
+        auto menu = Menu();
+        menu.populate(files);
+
+        WHEN("refreshed with a new desktop file") {
+            FileX(changed_file_name).writeLines({ "[Desktop Entry]", "Name=Editor", "Icon=editor", "Exec=editor", "Categories=Utility;" });
+            menu.refresh({ changed_file_name });
+            menu.sort();
+
+            THEN("the new desktop file is added") {
+                auto accessories = menu.subcategories()[1].desktopEntries();
+                REQUIRE(accessories.size() == 2);
+                CHECK(accessories[0].name() == "Editor");
+                CHECK(accessories[1].name() == "Mousepad");
+                CHECK(menu.summary().totalParsedFiles() == 3);
+            }
+
+            WHEN("the desktop file is changed and refreshed") {
+                remove(changed_file_name.c_str());
+                FileX(changed_file_name).writeLines({ "[Desktop Entry]", "Name=Player", "Icon=player", "Exec=player", "Categories=AudioVideo;" });
+                menu.refresh({ changed_file_name });
+                menu.sort();
+
+                THEN("it is moved to its new subcategory") {
+                    auto subcategories = menu.subcategories();
+                    REQUIRE(subcategories[1].desktopEntries().size() == 1);
+                    auto multimedia = subcategories[7].desktopEntries();
+                    REQUIRE(multimedia.size() == 2);
+                    CHECK(multimedia[0].name() == "Player");
+                    CHECK(menu.summary().totalParsedFiles() == 3);
+                }
+            }
+
+            WHEN("the desktop file is removed and refreshed") {
+                remove(changed_file_name.c_str());
+                menu.refresh({ changed_file_name });
+
+                THEN("it is dropped from the menu and the summary") {
+                    CHECK(menu.subcategories()[1].desktopEntries().size() == 1);
+                    CHECK(menu.summary().totalParsedFiles() == 2);
+                    CHECK(menu.subcategories().size() == 12);
+                }
+            }
+        }
+
+        remove(changed_file_name.c_str());
+    }
+}
+
+SCENARIO("Menu populated with a manifest", "[menu]") {
+    GIVEN("Desktop files populated into a menu with a manifest") {
+        auto manifest_file_name = std::string { "test/fixtures/menu-manifest" };
+        remove(manifest_file_name.c_str());
+        auto files = std::vector<std::string> {
+            kapplicationFixturesDirectory + "vlc.desktop",
+            kapplicationFixturesDirectory + "missing.desktop",
+            kapplicationFixturesDirectory + "does-not-exist.desktop",
+            kapplicationFixturesDirectory + "mousepad.desktop",
+        };
+
+        auto first_menu = Menu();
+        first_menu.registerManifest(new DesktopEntryManifest(manifest_file_name, "en"));
+        first_menu.populate(files);
+
+        THEN("every desktop file is read") {
+            CHECK(first_menu.summary().manifestHits() == 0);
+            CHECK(first_menu.summary().manifestMisses() == 4);
+        }
+
+        WHEN("populated again from the saved manifest") {
+            first_menu.registerManifest(nullptr);
+            auto menu = Menu();
+            menu.registerManifest(new DesktopEntryManifest(manifest_file_name, "en"));
+            menu.populate(files);
+
+            THEN("unchanged desktop files aren't read again") {
+                CHECK(menu.summary().manifestHits() == 3);
+                CHECK(menu.summary().manifestMisses() == 1);
+            }
+
+            THEN("the menu is the same") {
+                auto transformer = TestTransformer();
+                auto first_representations = first_menu.representations();
+                auto representations = menu.representations();
+                REQUIRE(first_representations.size() == representations.size());
+                for (size_t i = 0; i < representations.size(); ++i) {
+                    CHECK(first_representations[i]->visit(transformer) == representations[i]->visit(transformer));
+                }
+                CHECK(first_menu.summary().details("normal") == menu.summary().details("normal"));
+            }
+        }
+
+        remove(manifest_file_name.c_str());
+    }
+}
+
 SCENARIO("Menu representations", "[menu]") {
     GIVEN("A menu") {
         auto menu = Menu();
@@ -312,6 +507,24 @@ SCENARIO("Menu representations", "[menu]") {
             }
         }
 
+        WHEN("transformed into an output") {
+            auto files = std::vector<std::string> { kapplicationFixturesDirectory + "vlc.desktop", kapplicationFixturesDirectory + "mousepad.desktop" };
+
+            menu.populate(files);
+            auto transformer = TestTransformer();
+            auto output = std::string { "header\n" };
+            menu.transform(transformer, &output);
+
+            THEN("it appends each representation on a line of its own") {
+                auto expected = std::string { "header\n" };
+                for (const auto &representation : menu.representations()) {
+                    expected += representation->visit(transformer) + "\n";
+                }
+                CHECK(output == expected);
+                CHECK(output.compare(0, 41, "header\nMenu start--> name: Menu start\nSub") == 0);
+            }
+        }
+
         WHEN("transformed to a representations with a custom language") {
             auto files = std::vector<std::string> { kapplicationFixturesDirectory + "vlc.desktop", kapplicationFixturesDirectory + "mousepad.desktop" };
 
@@ -337,4 +550,38 @@ SCENARIO("Menu representations", "[menu]") {
     }
 }
 
+SCENARIO("Menu traced", "[menu]") {
+    GIVEN("A menu with a registered trace") {
+        auto menu = Menu();
+        Trace trace;
+        menu.registerTrace(&trace);
+        auto files = std::vector<std::string> { kapplicationFixturesDirectory + "vlc.desktop", kapplicationFixturesDirectory + "mousepad.desktop" };
+
+        WHEN("populated and transformed to representations") {
+            menu.registerJobs(2);
+            menu.populate(files);
+            menu.representations();
+
+            THEN("each desktop file read and each batch of icon searches is a span") {
+                CHECK(trace.size() == 4);
+                auto json = trace.json();
+                CHECK(json.find("\"name\":\"parse\",\"cat\":\"desktop_entry\"") != std::string::npos);
+                CHECK(json.find("\"file\":\"test/fixtures/applications/vlc.desktop\"") != std::string::npos);
+                CHECK(json.find("\"name\":\"resolve\",\"cat\":\"icon\"") != std::string::npos);
+                CHECK(json.find("\"icons\":\"2\"") != std::string::npos);
+            }
+        }
+
+        WHEN("the trace is unregistered") {
+            menu.registerTrace(nullptr);
+            menu.populate(files);
+            menu.representations();
+
+            THEN("nothing is recorded") {
+                CHECK(trace.size() == 0);
+            }
+        }
+    }
+}
+
 } // namespace amm
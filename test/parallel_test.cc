@@ -0,0 +1,72 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "parallel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace amm {
+
+SCENARIO("parallel::forEach", "[parallel]") {
+    GIVEN("A number of tasks") {
+        auto count = size_t { 100 };
+        std::vector<int> runs(count, 0);
+
+        WHEN("run on a single job") {
+            parallel::forEach(count, 1, [&](size_t i) { runs[i]++; });
+
+            THEN("every task is run once") {
+                CHECK(runs == std::vector<int>(count, 1));
+            }
+        }
+
+        WHEN("run on multiple jobs") {
+            std::atomic<int> total(0);
+            parallel::forEach(count, 4, [&](size_t i) { runs[i]++; total++; });
+
+            THEN("every task is run once") {
+                CHECK(runs == std::vector<int>(count, 1));
+                CHECK(total == 100);
+            }
+        }
+
+        WHEN("run on more jobs than tasks") {
+            parallel::forEach(3, 8, [&](size_t i) { runs[i]++; });
+
+            THEN("only the given tasks are run") {
+                CHECK(runs[0] == 1);
+                CHECK(runs[2] == 1);
+                CHECK(runs[3] == 0);
+            }
+        }
+
+        WHEN("there are no tasks") {
+            parallel::forEach(0, 4, [&](size_t i) { runs[i]++; });
+
+            THEN("nothing is run") {
+                CHECK(runs == std::vector<int>(count, 0));
+            }
+        }
+    }
+}
+
+} // namespace amm
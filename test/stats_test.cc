@@ -115,6 +115,14 @@ SCENARIO("Stats totals", "[stats]") {
             THEN("it has no suppressed files")   { CHECK(stats.totalSuppressedFiles() == 0); }
             THEN("it has one unparsed files")    { CHECK(stats.totalUnparsedFiles() == 1); }
         }
+
+        WHEN("manifest hits and misses are added") {
+            stats.addManifestHits(3);
+            stats.addManifestMisses(1);
+
+            THEN("it has the manifest hits")   { CHECK(stats.manifestHits() == 3); }
+            THEN("it has the manifest misses") { CHECK(stats.manifestMisses() == 1); }
+        }
     }
 }
 
@@ -149,6 +157,23 @@ SCENARIO("Stats summaries", "[stats]") {
                 CHECK(stats.details("long") == expected_details);
             }
         }
+
+        WHEN("desktop files are looked up in a manifest") {
+            stats.addManifestHits(4);
+            stats.addManifestMisses(2);
+
+            THEN("details don't include the manifest") {
+                CHECK(stats.details("normal") == expectedNormalDetails());
+            }
+
+            THEN("long details include the manifest hits and misses") {
+                auto expected_details = expectedNormalDetails() +
+                                        "\nSuppressed files: mplayer"
+                                        "\nUnclassified files: htop, NEdit"
+                                        "\nManifest: 4 unchanged, 2 read";
+                CHECK(stats.details("long") == expected_details);
+            }
+        }
     }
 }
 
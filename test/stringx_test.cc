@@ -109,6 +109,17 @@ SCENARIO("StringX", "[stringx]") {
         }
     }
 
+    GIVEN("A stringx with tabs, newlines and backslashes") {
+        auto stringx = StringX("/icons/a\tb\nc\\d.png");
+
+        WHEN("escaped as a field") {
+            auto result = stringx.escapeField();
+            THEN("they are replaced by backslash escape sequences") {
+                CHECK(result == "/icons/a\\tb\\nc\\\\d.png");
+            }
+        }
+    }
+
     GIVEN("A stringx with whitespaces at extremes") {
         auto stringx = StringX(" \taccessories-text-editor \t\n");
 
@@ -119,6 +130,34 @@ SCENARIO("StringX", "[stringx]") {
             }
         }
     }
+
+    GIVEN("A stringx with content to digest") {
+        WHEN("digested") {
+            THEN("it is a fixed width hexadecimal FNV-1a hash") {
+                CHECK(StringX("").digest() == "cbf29ce484222325");
+                CHECK(StringX("a").digest() == "af63dc4c8601ec8c");
+            }
+
+            THEN("different contents have different digests") {
+                CHECK(StringX("hicolor").digest() != StringX("Hicolor").digest());
+            }
+        }
+    }
+
+    GIVEN("Stringx names to collate in the default C locale") {
+        WHEN("their collation keys are compared") {
+            THEN("they are ordered byte-wise") {
+                CHECK(StringX("Mousepad").collationKey() < StringX("Sakura").collationKey());
+                CHECK(StringX("Zathura").collationKey() < StringX("abiword").collationKey());
+                CHECK(StringX("Mouse").collationKey() < StringX("Mousepad").collationKey());
+            }
+
+            THEN("equal names have equal keys") {
+                CHECK(StringX("Mousepad").collationKey() == StringX("Mousepad").collationKey());
+                CHECK(StringX("").collationKey() == "");
+            }
+        }
+    }
 }
 
 } // namespace amm
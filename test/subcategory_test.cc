@@ -50,26 +50,47 @@ static xdg::DesktopEntry sakuraDesktopEntry() {
     return entry;
 }
 
+static xdg::DesktopEntry sakuraInTabsDesktopEntry() {
+    auto entry = xdg::DesktopEntry();
+    entry.parse(std::vector<std::string> {
+        "[Desktop Entry]",
+        "Name=Sakura",
+        "Icon=terminal-tango",
+        "Exec=sakura --tabs",
+        "Categories=GTK;Utility;TerminalEmulator;System;",
+    });
+    return entry;
+}
+
 SCENARIO("subcategory", "[subcategory]") {
-    GIVEN("A subcategory") {
+    GIVEN("A subcategory drawing from a pool of desktop entries") {
+        auto pool = std::vector<xdg::DesktopEntry> { sakuraDesktopEntry(), mousepadDesktopEntry(), sakuraDesktopEntry() };
         Subcategory subcategory("Accessories", "accessories", "Utilities");
+        subcategory.drawsFrom(&pool);
 
         WHEN("without desktop-files") {
             THEN("it has no entries") {
                 CHECK_FALSE(subcategory.hasEntries());
+                CHECK(subcategory.desktopEntries().empty());
             }
         }
 
         WHEN("with one desktop-file") {
-            subcategory.addDesktopEntry(mousepadDesktopEntry());
+            subcategory.addDesktopEntry(1);
             THEN("it has entries") {
                 CHECK(subcategory.hasEntries());
             }
+
+            THEN("its entries are taken from the pool") {
+                std::vector<xdg::DesktopEntry> desktop_entries = subcategory.desktopEntries();
+                REQUIRE(desktop_entries.size() == 1);
+                CHECK(desktop_entries[0].name() == "Mousepad");
+            }
         }
 
         WHEN("with two desktop-file") {
-            subcategory.addDesktopEntry(sakuraDesktopEntry());
-            subcategory.addDesktopEntry(mousepadDesktopEntry());
+            subcategory.addDesktopEntry(0);
+            subcategory.addDesktopEntry(1);
             WHEN("sorted") {
                 subcategory.sortDesktopEntries();
                 THEN("its entries are alphabetically sorted by name") {
@@ -78,13 +99,36 @@ SCENARIO("subcategory", "[subcategory]") {
                     CHECK(desktop_entries[0].name() == "Mousepad");
                     CHECK(desktop_entries[1].name() == "Sakura");
                 }
+
+                THEN("only its positions in the pool are reordered") {
+                    CHECK(subcategory.desktopEntryIndices() == (std::vector<size_t> { 1, 0 }));
+                    CHECK(pool[0].name() == "Sakura");
+                }
+            }
+        }
+
+        WHEN("a desktop file equal to an earlier one is added") {
+            subcategory.addDesktopEntry(2);
+            subcategory.addDesktopEntry(1);
+            subcategory.addDesktopEntry(0);
+            THEN("only the first one is kept") {
+                CHECK(subcategory.desktopEntryIndices() == (std::vector<size_t> { 2, 1 }));
+            }
+        }
+
+        WHEN("sorted with collation keys") {
+            subcategory.addDesktopEntry(0);
+            subcategory.addDesktopEntry(1);
+            subcategory.sortDesktopEntries({ "b", "a", "a" });
+            THEN("its entries are ordered by key") {
+                CHECK(subcategory.desktopEntryIndices() == (std::vector<size_t> { 1, 0 }));
             }
         }
 
         WHEN("with a repeated desktop file") {
-            subcategory.addDesktopEntry(sakuraDesktopEntry());
-            subcategory.addDesktopEntry(mousepadDesktopEntry());
-            subcategory.addDesktopEntry(sakuraDesktopEntry());
+            subcategory.addDesktopEntry(0);
+            subcategory.addDesktopEntry(1);
+            subcategory.addDesktopEntry(2);
             WHEN("sorted") {
                 subcategory.sortDesktopEntries();
                 THEN("it doesn't repeat entries") {
@@ -96,6 +140,22 @@ SCENARIO("subcategory", "[subcategory]") {
             }
         }
     }
+
+    GIVEN("A subcategory with duplicates that don't sort next to each other") {
+        auto pool = std::vector<xdg::DesktopEntry> { sakuraDesktopEntry(), sakuraInTabsDesktopEntry(), sakuraDesktopEntry() };
+        Subcategory subcategory("Accessories", "accessories", "Utilities");
+        subcategory.drawsFrom(&pool);
+        subcategory.addDesktopEntry(0);
+        subcategory.addDesktopEntry(1);
+        subcategory.addDesktopEntry(2);
+
+        WHEN("sorted") {
+            subcategory.sortDesktopEntries();
+            THEN("the duplicate is still left out, and the first one found is kept") {
+                CHECK(subcategory.desktopEntryIndices() == (std::vector<size_t> { 0, 1 }));
+            }
+        }
+    }
 }
 
 } // namespace amm
@@ -79,6 +79,46 @@ SCENARIO("SystemEnvironment", "[systemenvironment]") {
             }
         }
 
+        GIVEN("XDG_CACHE_HOME is set") {
+            setenv("XDG_CACHE_HOME", "/cache/home", 1);
+
+            WHEN("XDG cache home is asked") {
+                THEN("it is the directory pointed to by XDG_CACHE_HOME") {
+                    CHECK(SystemEnvironment().xdgCacheHome() == "/cache/home");
+                }
+            }
+        }
+
+        GIVEN("XDG_CACHE_HOME is unset") {
+            unsetenv("XDG_CACHE_HOME");
+
+            WHEN("XDG cache home is asked") {
+                THEN("it is $HOME/.cache") {
+                    CHECK(SystemEnvironment().xdgCacheHome() == "/home/amm/.cache");
+                }
+            }
+        }
+
+        GIVEN("XDG_CACHE_HOME is empty") {
+            setenv("XDG_CACHE_HOME", "", 1);
+
+            WHEN("XDG cache home is asked") {
+                THEN("it is $HOME/.cache") {
+                    CHECK(SystemEnvironment().xdgCacheHome() == "/home/amm/.cache");
+                }
+            }
+        }
+
+        GIVEN("XDG_CACHE_HOME is a relative path") {
+            setenv("XDG_CACHE_HOME", "cache/home", 1);
+
+            WHEN("XDG cache home is asked") {
+                THEN("it is $HOME/.cache") {
+                    CHECK(SystemEnvironment().xdgCacheHome() == "/home/amm/.cache");
+                }
+            }
+        }
+
         GIVEN("XDG_DATA_HOME is unset and XDG_DATA_DIRS is unset") {
             unsetenv("XDG_DATA_HOME");
             unsetenv("XDG_DATA_DIRS");
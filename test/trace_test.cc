@@ -0,0 +1,123 @@
+/*
+  This file is part of amm.
+  Copyright (C) 2014-2016  Chirantan Mitra <chirantan.mitra@gmail.com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trace.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "filex.h"
+
+namespace amm {
+
+SCENARIO("Trace", "[trace]") {
+    GIVEN("A trace") {
+        Trace trace;
+
+        WHEN("a span ends") {
+            {
+                Trace::Span span(&trace, "populate", "stage");
+                span.annotate("file", "a \"quoted\"\\path\n");
+            }
+
+            THEN("it is recorded") {
+                CHECK(trace.size() == 1);
+            }
+
+            THEN("it is a complete event with its name, category and arguments") {
+                auto json = trace.json();
+                CHECK(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+                CHECK(json.find("\"name\":\"populate\",\"cat\":\"stage\",\"ph\":\"X\",\"ts\":") != std::string::npos);
+                CHECK(json.find("\"tid\":1,\"args\":{\"file\":\"a \\\"quoted\\\"\\\\path\\n\"}}") != std::string::npos);
+                CHECK(json.substr(json.size() - 3) == "\n]}");
+            }
+        }
+
+        WHEN("a span has arguments that aren't all UTF-8") {
+            {
+                Trace::Span span(&trace, "populate", "stage");
+                span.annotate("file", "caf\xc3\xa9-\xe9t\xc3\xa9\xff");
+            }
+
+            THEN("well-formed sequences are kept and other bytes are escaped") {
+                CHECK(trace.json().find("\"file\":\"caf\xc3\xa9-\\u00e9t\xc3\xa9\\u00ff\"") != std::string::npos);
+            }
+        }
+
+        WHEN("spans are nested") {
+            {
+                Trace::Span outer(&trace, "outer", "stage");
+                Trace::Span inner(&trace, "inner", "stage");
+            }
+
+            THEN("the inner span ends first") {
+                auto json = trace.json();
+                CHECK(json.find("\"inner\"") < json.find("\"outer\""));
+            }
+        }
+
+        WHEN("spans end on different threads") {
+            { Trace::Span span(&trace, "main", "stage"); }
+            std::thread worker([&trace] { Trace::Span span(&trace, "worker", "stage"); });
+            worker.join();
+
+            THEN("each thread has its own id") {
+                auto json = trace.json();
+                CHECK(json.find("\"name\":\"worker\",\"cat\":\"stage\",\"ph\":\"X\"") != std::string::npos);
+                CHECK(json.find(",\"tid\":2}") != std::string::npos);
+            }
+        }
+
+        WHEN("a span has no trace") {
+            {
+                Trace::Span span(nullptr, "populate", "stage");
+                span.annotate("file", "vlc.desktop");
+            }
+
+            THEN("nothing is recorded") {
+                CHECK(trace.size() == 0);
+            }
+        }
+
+        WHEN("saved") {
+            auto file_name = std::string { "test/fixtures/amm.trace.json" };
+            { Trace::Span span(&trace, "populate", "stage"); }
+            FileX(file_name).writeLines({ "an older trace" });
+
+            THEN("an earlier file is replaced by the trace") {
+                REQUIRE(trace.save(file_name));
+                std::string content;
+                REQUIRE(FileX(file_name).readAll(&content));
+                CHECK(content == trace.json() + "\n");
+            }
+
+            remove(file_name.c_str());
+        }
+
+        WHEN("saved to an inaccessible location") {
+            THEN("it fails") {
+                CHECK_FALSE(trace.save("test/does-not-exist-fixtures/amm.trace.json"));
+            }
+        }
+    }
+}
+
+} // namespace amm
@@ -84,6 +84,23 @@ SCENARIO("transformer::Jwm", "[transformerjwm]") {
                 auto program = representation::Program("Mousepad", "application-text-editor", "mousepad %F", "Simple Text Editor");
                 CHECK(transformer.transform(program) == "        <Program label=\"Mousepad\" icon=\"application-text-editor\">mousepad</Program>");
             }
+
+            THEN("it keeps the other tokens of the executable as they are") {
+                auto program = representation::Program("Terminal", "terminal", "%k xterm  -e %f top", "Terminal");
+                CHECK(transformer.transform(program) == "        <Program label=\"Terminal\" icon=\"terminal\">xterm  -e top</Program>");
+            }
+        }
+
+        WHEN("transforming representations into an output") {
+            auto output = std::string { "<?xml?>\n" };
+            auto program = representation::Program("Shoot & Run", "shooter.png", "/usr/bin/shooter %U", "Run");
+            auto subcategory_end = representation::SubcategoryEnd("Games");
+            program.visit(transformer, &output);
+            subcategory_end.visit(transformer, &output);
+
+            THEN("each is appended to the output as it would be transformed on its own") {
+                CHECK(output == "<?xml?>\n" + transformer.transform(program) + transformer.transform(subcategory_end));
+            }
         }
     }
 }
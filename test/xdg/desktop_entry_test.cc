@@ -65,6 +65,37 @@ SCENARIO("Populate DesktopEntry", "[desktopfile]") {
                 CHECK(entry.display());
             }
 
+            THEN("a copy has the same fields") {
+                auto copy = entry;
+                CHECK(copy == entry);
+                CHECK(copy.name() == "Mousepad");
+                CHECK(copy.comment() == "Simple Text Editor");
+                CHECK(copy.categories() == entry.categories());
+            }
+
+            WHEN("categories aren't ended by ';'") {
+                auto lines = std::vector<std::string> {
+                    "[Desktop Entry]\n",
+                    "Categories=Utility;;GTK\n",
+                };
+                entry.parse(lines);
+                THEN("every category is kept, including empty ones") {
+                    CHECK(entry.categories() == (std::vector<std::string> { "", "GTK", "Utility" }));
+                    CHECK(entry.isA("GTK"));
+                }
+            }
+
+            WHEN("categories begin with ';'") {
+                auto lines = std::vector<std::string> {
+                    "[Desktop Entry]\n",
+                    "Categories=;Utility;\n",
+                };
+                entry.parse(lines);
+                THEN("it has no categories") {
+                    CHECK(entry.categories().empty());
+                }
+            }
+
             WHEN("NoDisplay is set to true") {
                 auto lines = std::vector<std::string> {
                     "[Desktop Entry]\n",
@@ -120,6 +151,56 @@ SCENARIO("Language-aware DesktopEntry", "[focus]") {
 }
 
 
+SCENARIO("DesktopEntry parsed from file content", "[desktopfile]") {
+    GIVEN("A desktop-file") {
+        auto entry = DesktopEntry();
+        entry.hasLanguage("sr");
+
+        WHEN("parsed from its content") {
+            auto content = std::string {
+                "# A comment\n"
+                "Name=Outside any section\n"
+                "[Desktop Entry]\n"
+                "Comment[sr]=Једноставан уређивач текста\n"
+                " Name = Mousepad \n"
+                "Comment=Simple Text Editor\n"
+                "Icon=accessories-text-editor\r\n"
+                "GenericName=Text Editor\n"
+                "Exec=mousepad %F\n"
+                "\n"
+                "[Desktop Action Window]\n"
+                "Name=New Window\n"
+                "Exec=mousepad --new-window\n"
+                "Categories=Utility;\n"
+            };
+            entry.parse(content);
+
+            THEN("it reads keys from the desktop entry section only") {
+                CHECK(entry.name() == "Mousepad");
+                CHECK(entry.executable() == "mousepad %F");
+                CHECK(entry.categories().empty());
+            }
+
+            THEN("it ignores surrounding whitespaces") {
+                CHECK(entry.icon() == "accessories-text-editor");
+            }
+
+            THEN("it prefers the matching language irrespective of order") {
+                CHECK(entry.comment() == "Једноставан уређивач текста");
+            }
+        }
+
+        WHEN("parsed from content without a trailing newline") {
+            auto content = std::string { "[Desktop Entry]\nName[sr-latin]=Mišolovka\nName=Mousepad" };
+            entry.parse(content);
+
+            THEN("it reads the last line") {
+                CHECK(entry.name() == "Mousepad");
+            }
+        }
+    }
+}
+
 SCENARIO("DesktopEntry comparisons", "[desktopfile]") {
     auto entry = DesktopEntry();
     DesktopEntry other_entry;
@@ -132,6 +213,17 @@ SCENARIO("DesktopEntry comparisons", "[desktopfile]") {
         };
         entry.parse(lines);
 
+        WHEN("compared to a desktop-file without any keys") {
+            other_entry.parse(std::vector<std::string> { "[Desktop Entry]\n" });
+
+            THEN("the one without a name is lesser and they differ") {
+                CHECK(other_entry < entry);
+                CHECK_FALSE(entry < other_entry);
+                CHECK(other_entry != entry);
+                CHECK(other_entry == DesktopEntry());
+            }
+        }
+
         WHEN("compared to another desktop-file") {
             WHEN("the other desktop-file has an alphabetically greater name") {
                 auto other_lines = std::vector<std::string> {
@@ -294,6 +386,25 @@ SCENARIO("DesktopEntry classifications", "[desktopfile]") {
                 auto classifications = std::vector<std::string> { "AudioVideo", "Multimedia" };
                 CHECK_FALSE(entry.isAnyOf(classifications));
             }
+
+            THEN("it is each of its categories, whatever their sorted position") {
+                CHECK(entry.isA("Audio"));
+                CHECK(entry.isA("Video"));
+                CHECK_FALSE(entry.isA("Vide"));
+                CHECK_FALSE(entry.isA("Zzz"));
+            }
+        }
+
+        WHEN("it has no categories") {
+            auto lines = std::vector<std::string> {
+                "[Desktop Entry]\n",
+                "Name=Mousepad\n",
+            };
+            entry.parse(lines);
+            THEN("it is nothing") {
+                CHECK_FALSE(entry.isA("AudioVideo"));
+                CHECK_FALSE(entry.isA(""));
+            }
         }
     }
 }
@@ -47,6 +47,10 @@ SCENARIO("xdg::IconSubdirectory", "[iconsubdir]") {
             THEN("its threshold is 2") {
                 CHECK(subdir.threshold() == 2);
             }
+
+            THEN("it has no context") {
+                CHECK(subdir.context() == "");
+            }
         }
 
         WHEN("when optional values are empty") {
@@ -85,6 +89,27 @@ SCENARIO("xdg::IconSubdirectory", "[iconsubdir]") {
         }
     }
 
+    GIVEN("Subdirectories with contexts") {
+        WHEN("the context is Applications or Categories") {
+            THEN("it holds menu icons") {
+                CHECK(IconSubdirectory("48x48/apps", "48").context("Applications").holdsMenuIcons());
+                CHECK(IconSubdirectory("48x48/categories", "48").context("categories").holdsMenuIcons());
+            }
+        }
+
+        WHEN("the context is unknown") {
+            THEN("it may hold menu icons") {
+                CHECK(IconSubdirectory("48x48/apps", "48").holdsMenuIcons());
+            }
+        }
+
+        WHEN("the context is another one") {
+            THEN("it doesn't hold menu icons") {
+                CHECK_FALSE(IconSubdirectory("48x48/mimetypes", "48").context("MimeTypes").holdsMenuIcons());
+            }
+        }
+    }
+
     GIVEN("A fixed subdirectory") {
         auto fixed = IconSubdirectory("fixed", "24").type("Fixed");
 
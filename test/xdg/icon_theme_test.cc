@@ -155,6 +155,10 @@ SCENARIO("xdg::IconTheme", "[icontheme]") {
             THEN("the sub-directory has a threshold") {
                 CHECK(scalable_apps.threshold() == 208);
             }
+
+            THEN("the sub-directory has a context") {
+                CHECK(scalable_apps.context() == "Applications");
+            }
         }
     }
 }